@@ -1722,7 +1722,9 @@ ARDOUR_UI::update_peak_thread_work ()
 	char buf[64];
 	const int c = SourceFactory::peak_work_queue_length ();
 	if (c > 0) {
-		snprintf (buf, sizeof (buf), _("PkBld: <span foreground=\"%s\">%d</span>"), c >= 2 ? X_("red") : X_("green"), c);
+		uint32_t done, total;
+		SourceFactory::peak_work_progress (done, total);
+		snprintf (buf, sizeof (buf), _("PkBld: <span foreground=\"%s\">%u</span>/%u"), c >= 2 ? X_("red") : X_("green"), done, total);
 		peak_thread_work_label.set_markup (buf);
 	} else {
 		peak_thread_work_label.set_markup (X_(""));
@@ -73,6 +73,7 @@
 #include "ardour/route.h"
 #include "ardour/route_group.h"
 #include "ardour/session_playlists.h"
+#include "ardour/source_factory.h"
 #include "ardour/tempo.h"
 #include "ardour/utils.h"
 #include "ardour/vca_manager.h"
@@ -4682,9 +4683,60 @@ Editor::visual_changer (const VisualChange& vc)
 		update_video_timeline();
 	}
 
+	prioritize_visible_peakfiles ();
+
 	_summary->set_overlays_dirty ();
 }
 
+/** Move the sources of regions that intersect the visible canvas area to the
+ *  front of the peak-building queue, so that what is on display gets its
+ *  waveforms first.
+ */
+void
+Editor::prioritize_visible_peakfiles ()
+{
+	if (SourceFactory::peak_work_queue_length () == 0) {
+		return;
+	}
+
+	double const view_min_y = vertical_adjustment.get_value ();
+	double const view_max_y = view_min_y + vertical_adjustment.get_page_size ();
+	samplepos_t const start = _leftmost_sample;
+	samplepos_t const end = _leftmost_sample + current_page_samples ();
+
+	for (TrackViewList::const_iterator t = track_views.begin(); t != track_views.end(); ++t) {
+
+		RouteTimeAxisView* rtv = dynamic_cast<RouteTimeAxisView*> (*t);
+
+		if (!rtv || rtv->hidden ()) {
+			continue;
+		}
+
+		if (rtv->y_position () >= view_max_y || rtv->y_position () + rtv->effective_height () <= view_min_y) {
+			continue;
+		}
+
+		boost::shared_ptr<AudioTrack> tr = boost::dynamic_pointer_cast<AudioTrack> (rtv->track ());
+		boost::shared_ptr<Playlist> pl;
+
+		if (!tr || !(pl = tr->playlist ())) {
+			continue;
+		}
+
+		boost::shared_ptr<RegionList> regions = pl->regions_touched (start, end);
+
+		for (RegionList::const_iterator i = regions->begin(); i != regions->end(); ++i) {
+			boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*i);
+			if (!ar) {
+				continue;
+			}
+			for (uint32_t n = 0; n < ar->n_channels (); ++n) {
+				SourceFactory::prioritize_peakfile (ar->audio_source (n));
+			}
+		}
+	}
+}
+
 struct EditorOrderTimeAxisSorter {
     bool operator() (const TimeAxisView* a, const TimeAxisView* b) const {
 	    return a->order () < b->order ();
@@ -1158,6 +1158,7 @@ private:
 	static int _idle_visual_changer (void *arg);
 	int idle_visual_changer ();
 	void visual_changer (const VisualChange&);
+	void prioritize_visible_peakfiles ();
 	void ensure_visual_change_idle_handler ();
 
 	/* track views */
@@ -2158,6 +2158,30 @@ RCOptionEditor::RCOptionEditor ()
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("General"), procs);
+
+		bo = new BoolOption (
+				"work-stealing-graph",
+				_("Use work-stealing process graph scheduler"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_work_stealing_graph),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_work_stealing_graph)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("<b>When enabled</b> every DSP thread keeps its own queue of routes ready to run, and idle threads take work from busy ones. "
+				  "This scales better on machines with many cores.\n"
+				  "<b>When disabled</b> all DSP threads share a single queue."));
+		add_option (_("General"), bo);
+
+		bo = new BoolOption (
+				"parallel-plugin-replicas",
+				_("Process replicated plugin instances in parallel"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_parallel_plugin_replicas),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_parallel_plugin_replicas)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("<b>When enabled</b> a plugin that is replicated to process many channels (e.g. a mono plugin on a multi-channel track) runs its instances concurrently on the DSP threads. "
+				  "This helps when a single wide track with heavy plugins limits the whole process cycle.\n"
+				  "<b>When disabled</b> the instances are run one after another."));
+		add_option (_("General"), bo);
 	}
 
 	/* Image cache size */
@@ -2258,6 +2282,18 @@ RCOptionEditor::RCOptionEditor ()
 		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_periodic_safety_backups)
 		     ));
 
+	bo = new BoolOption (
+		"save-binary-state",
+		_("Save a binary copy of the session file"),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::get_save_binary_state),
+		sigc::mem_fun (*_rc_config, &RCConfiguration::set_save_binary_state)
+		);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+					    string_compose (_("<b>When enabled</b> %1 also writes the session state in a binary form next to the session file, "
+							      "which loads faster for large sessions. It is only used as long as the session file is unchanged."),
+							    PROGRAM_NAME));
+	add_option (_("General/Session"), bo);
+
 	add_option (_("General/Session"),
 	     new BoolOption (
 		     "only-copy-imported-files",
@@ -2711,6 +2747,38 @@ RCOptionEditor::RCOptionEditor ()
 
 	add_option (_("Audio"), new BufferingOptions (_rc_config));
 
+#ifdef __linux__
+	bo = new BoolOption (
+		     "preallocate-capture-files",
+		     _("Reserve disk space for recordings in advance"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_preallocate_capture_files),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_preallocate_capture_files)
+		     );
+	add_option (_("Audio"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, recorded files grow in large steps of preallocated disk space instead of with every write."));
+
+	bo = new BoolOption (
+		     "capture-write-behind",
+		     _("Write recordings to disk continuously"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_capture_write_behind),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_capture_write_behind)
+		     );
+	add_option (_("Audio"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, recorded data is written to disk as it arrives and not kept in the system's file cache. This avoids large bursts of disk activity when recording many tracks."));
+
+	bo = new BoolOption (
+		     "batch-disk-reads",
+		     _("Read ahead for all tracks at once"),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::get_batch_disk_reads),
+		     sigc::mem_fun (*_rc_config, &RCConfiguration::set_batch_disk_reads)
+		     );
+	add_option (_("Audio"), bo);
+	Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+			_("When enabled, the audio files that all tracks are about to play are requested from the disk together, in file order, before tracks read them one by one."));
+#endif
+
 	add_option (_("Audio"), new OptionEditorHeading (_("Denormals")));
 
 	add_option (_("Audio"),
@@ -60,6 +60,11 @@ public:
 	virtual int update_header (samplepos_t when, struct tm&, time_t) = 0;
 	virtual int flush_header () = 0;
 
+	/** Ask the OS to start reading @a cnt samples from @a start into its
+	 * cache, without waiting for the data. Does nothing if not supported.
+	 */
+	virtual void prefetch (samplepos_t /*start*/, samplecnt_t /*cnt*/) {}
+
 	void mark_streaming_write_completed (const Lock& lock);
 
 	int setup_peakfile ();
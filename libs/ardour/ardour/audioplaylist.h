@@ -42,6 +42,7 @@ public:
 	AudioPlaylist (boost::shared_ptr<const AudioPlaylist>, samplepos_t start, samplecnt_t cnt, std::string name, bool hidden = false);
 
 	samplecnt_t read (Sample *dst, Sample *mixdown, float *gain_buffer, samplepos_t start, samplecnt_t cnt, uint32_t chan_n=0);
+	samplecnt_t read_channels (Sample **dst, uint32_t n_chans, Sample *mixdown, float *gain_buffer, samplepos_t start, samplecnt_t cnt, uint32_t first_chan=0);
 
 	bool destroy_region (boost::shared_ptr<Region>);
 
@@ -36,6 +36,8 @@
 #include "pbd/stateful.h"
 #include "pbd/xml++.h"
 
+class PeakLevelsTest;
+
 namespace ARDOUR {
 
 class LIBARDOUR_API AudioSource : virtual public Source,
@@ -83,6 +85,21 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	int rename_peakfile (std::string newpath);
 	void touch_peakfile ();
 
+	/** number of coarser levels kept in addition to the main peakfile */
+	static const uint32_t n_peak_levels = 2;
+	/** @return path of the peak file for level @a level (0 .. n_peak_levels-1) of @a peakpath */
+	static std::string peak_level_path (const std::string& peakpath, uint32_t level);
+
+	/** @return true if the levels are missing for an existing peakfile,
+	 * and are to be built by build_peak_levels(). Until then, reads use
+	 * the main peakfile.
+	 */
+	bool peak_levels_pending () const { return g_atomic_int_get (&_peak_levels_pending); }
+	/** build pending peak levels from the main peakfile (called by the
+	 * SourceFactory peak threads)
+	 */
+	int build_peak_levels ();
+
 	static void set_build_missing_peakfiles (bool yn) {
 		_build_missing_peakfiles = yn;
 	}
@@ -143,11 +160,19 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 					 samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
 					 double samples_per_visual_peak, samplecnt_t fpp) const;
 
+	int read_peaks_from_peakfile (const std::string& path, PeakData *peaks,
+				      samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
+				      double samples_per_visual_peak, samplecnt_t fpp) const;
+
+	void remove_peak_levels ();
+
 	int compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, samplecnt_t cnt,
 				     bool force, bool intermediate_peaks_ready_signal,
 				     samplecnt_t samples_per_peak);
 
   private:
+	friend class ::PeakLevelsTest;
+
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
 	 *  variable and also the emission (and handling) of the
@@ -169,6 +194,33 @@ class LIBARDOUR_API AudioSource : virtual public Source,
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
+
+	/** A coarser level of the peak data pyramid. Every level is kept
+	 * in a peak file of its own, in the same format as the main one,
+	 * and is computed from the level below while peaks are written.
+	 */
+	struct PeakLevel {
+		PeakLevel () : fpp (0), fd (-1), index (-1), byte_max (0), built (false) {}
+		samplecnt_t fpp;
+		std::string path;
+		int         fd;
+		off_t       index;    ///< index of the peak being accumulated, -1 if none
+		PeakData    acc;      ///< the (partial) peak at index
+		off_t       byte_max;
+		bool        built;
+	};
+
+	PeakLevel _peak_levels[n_peak_levels];
+	mutable samplecnt_t _last_read_fpp;
+	gint _peak_levels_pending;
+
+	void setup_peak_levels ();
+	void open_peak_levels (bool truncate);
+	void close_peak_levels ();
+	int  accumulate_peak_levels (uint32_t level, PeakData const*, off_t first_index, samplecnt_t npeaks);
+	int  write_peak_level (uint32_t level, PeakData const*, off_t first_index, samplecnt_t npeaks);
+	int  flush_peak_levels ();
+	int  build_peak_levels_from_peakfile ();
 };
 
 }
@@ -138,6 +138,11 @@ private:
 	bool operator== (const AutomationList&) const { /* not called */ abort(); return false; }
 	XMLNode* _before; //used for undo of touch start/stop pairs.
 
+	/* the last serialized events, reused while ControlList::serial() is unchanged */
+	Glib::Threads::Mutex _events_cache_lock;
+	std::string          _events_cache;
+	gint                 _events_cache_serial;
+	bool                 _events_cache_valid;
 };
 
 } // namespace
@@ -21,13 +21,16 @@
 #define __ardour_butler_h__
 
 #include <pthread.h>
+#include <vector>
 
 #include <glibmm/threads.h>
 
 #include "pbd/crossthread.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/pool.h"
+#include "pbd/semutils.h"
 #include "ardour/libardour_visibility.h"
+#include "ardour/read_batch.h"
 #include "ardour/types.h"
 #include "ardour/session_handle.h"
 
@@ -35,6 +38,8 @@
 
 namespace ARDOUR {
 
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -93,6 +98,34 @@ private:
 
 	bool flush_tracks_to_disk_normal (boost::shared_ptr<RouteList>, uint32_t& errors);
 
+	/* Parallel disk refill.
+	 *
+	 * If "butler-refill-threads" is set, the butler thread hands the
+	 * tracks to refill to a pool of worker threads, and takes part in
+	 * the work itself. Transport work remains with the butler thread.
+	 */
+	int  start_refill_threads ();
+	void terminate_refill_threads ();
+	bool refill_tracks (std::vector<boost::shared_ptr<Track> > const&);
+	void refill_some (Sample* mixdown_buffer, gain_t* gain_buffer);
+
+	static void* _refill_thread_work (void *arg);
+	void*         refill_thread_work ();
+
+	std::vector<pthread_t>                   _refill_threads;
+	std::vector<boost::shared_ptr<Track> >   _refill_queue;
+	PBD::Semaphore                           _refill_start_sem;
+	PBD::Semaphore                           _refill_done_sem;
+	volatile gint                            _refill_next;
+	volatile gint                            _refill_outstanding;
+	volatile gint                            _refill_quit;
+
+	/* If "batch-disk-reads" is set, the file reads of all tracks are
+	 * collected, sorted and prefetched before each refill pass.
+	 */
+	void prefetch_tracks (RouteList const&);
+	ReadBatch _read_batch;
+
 	/**
 	 * Add request to butler thread request queue
 	 */
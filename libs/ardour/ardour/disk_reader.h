@@ -31,6 +31,7 @@ namespace ARDOUR
 class Playlist;
 class AudioPlaylist;
 class MidiPlaylist;
+class ReadBatch;
 template<typename T> class MidiRingBuffer;
 
 class LIBARDOUR_API DiskReader : public DiskIOProcessor
@@ -66,6 +67,13 @@ public:
 		return refill (_mixdown_buffer, _gain_buffer, 0);
 	}
 
+	/** For butler worker threads, which use their own working buffers
+	 * (each at least 2*1048576 samples, see _do_refill_with_alloc)
+	 */
+	int do_refill (Sample* mixdown_buffer, gain_t* gain_buffer) {
+		return refill (mixdown_buffer, gain_buffer, 0);
+	}
+
 	/** For non-butler contexts (allocates temporary working buffers)
 	 *
 	 * This accessible method has a default argument; derived classes
@@ -76,6 +84,9 @@ public:
 		return _do_refill_with_alloc (partial_fill);
 	}
 
+	/** Add the file reads that the next do_refill() will do to @a batch */
+	void add_read_requests (ReadBatch& batch) const;
+
 	bool pending_overwrite () const { return _pending_overwrite; }
 
 	// Working buffers for do_refill (butler thread)
@@ -127,7 +138,7 @@ private:
 	static samplecnt_t midi_readahead;
 	static bool       _no_disk_output;
 
-	int audio_read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
+	int audio_read (Sample** bufs, uint32_t n_chans, Sample* mixdown_buffer, float* gain_buffer,
 	                samplepos_t& start, samplecnt_t cnt,
 	                int channel, bool reversed);
 	int midi_read (samplepos_t& start, samplecnt_t cnt, bool reversed);
@@ -137,7 +148,10 @@ private:
 
 	int refill (Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level);
 	int refill_audio (Sample *mixdown_buffer, float *gain_buffer, samplecnt_t fill_level);
+	int refill_audio_channels (ChannelList const&, Sample *mixdown_buffer, float *gain_buffer,
+	                           samplepos_t& file_sample_tmp, samplecnt_t total_space, samplecnt_t samples_to_read, bool reversed);
 	int refill_midi ();
+	samplecnt_t refill_read_size (samplecnt_t total_space) const;
 
 	sampleoffset_t calculate_playback_distance (pframes_t);
 
@@ -190,7 +190,7 @@ private:
 	mutable Glib::Threads::Mutex _gui_feed_buffer_mutex;
 
 	void check_record_status (samplepos_t transport_sample, double speed, bool can_record);
-	void finish_capture (boost::shared_ptr<ChannelList> c);
+	void finish_capture (ChannelList const& c);
 };
 
 } // namespace
@@ -55,6 +55,7 @@ class LIBARDOUR_API ExportGraphBuilder
 {
   private:
 	typedef ExportHandler::FileSpec FileSpec;
+	typedef ExportHandler::ChannelData ChannelData;
 
 	typedef boost::shared_ptr<AudioGrapher::Sink<Sample> > FloatSinkPtr;
 	typedef boost::shared_ptr<AudioGrapher::IdentityVertex<Sample> > IdentityVertexPtr;
@@ -68,6 +69,12 @@ class LIBARDOUR_API ExportGraphBuilder
 	~ExportGraphBuilder ();
 
 	int process (samplecnt_t samples, bool last_cycle);
+
+	/* for timespans sharing a session pass: read all channels which are not
+	 * yet in @a data, then process @a samples starting at @a offset of them.
+	 */
+	void read_channels (ChannelData& data, samplecnt_t samples);
+	int process (ChannelData const& data, samplecnt_t offset, samplecnt_t samples, bool last_cycle);
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -269,7 +276,8 @@ class LIBARDOUR_API ExportGraphBuilder
 
 	bool _realtime;
 
-	Glib::ThreadPool thread_pool;
+	/* shared by all graphs, bounded by the number of cores */
+	static Glib::ThreadPool& thread_pool ();
 };
 
 } // namespace ARDOUR
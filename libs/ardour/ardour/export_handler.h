@@ -22,7 +22,9 @@
 #define __ardour_export_handler_h__
 
 #include <map>
+#include <vector>
 
+#include <boost/function.hpp>
 #include <boost/operators.hpp>
 #include <boost/shared_ptr.hpp>
 
@@ -92,6 +94,13 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 		BroadcastInfoPtr       broadcast_info;
 	};
 
+	/** Data of the current cycle, shared by the graphs of all
+	 * timespans that are exported in the same pass. Each channel
+	 * is read exactly once per cycle (channels may keep state,
+	 * e.g. latency compensation, so they are keyed by identity).
+	 */
+	typedef std::map<ExportChannel const *, Sample const *> ChannelData;
+
   private:
 	/* Session::get_export_handler() should be used to obtain an export handler
 	 * This ensures that it doesn't go out of scope before finalize_audio_export is called
@@ -112,6 +121,13 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
 	std::string get_cd_marker_filename(std::string filename, CDMarkerFormat format);
 
+	/** Of @a candidates (in any order), the timespans that are exported in
+	 * the same session pass as @a first, sorted by start. A timespan joins
+	 * if it starts no earlier than @a first, and overlaps the pass or starts
+	 * within @a max_gap of its end; the pass then extends to its end.
+	 */
+	static std::vector<ExportTimespanPtr> pass_group (ExportTimespanPtr first, std::vector<ExportTimespanPtr> candidates, samplecnt_t max_gap);
+
 	/** signal emitted when soundcloud export reports progress updates during upload.
 	 * The parameters are total and current bytes downloaded, and the current filename
 	 */
@@ -126,7 +142,6 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
   private:
 
-	void handle_duplicate_format_extensions();
 	int process (samplecnt_t samples);
 
 	Session &          session;
@@ -143,15 +158,59 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 
 	/* Timespan management */
 
+	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
+
+	/* A timespan exported in the current session pass, with a graph of its own.
+	 * With Config->get_export_timespans_in_one_pass() overlapping timespans
+	 * share a pass, otherwise there is only one.
+	 */
+	struct PassTimespan {
+		PassTimespan (ExportTimespanPtr timespan, boost::shared_ptr<ExportGraphBuilder> graph_builder)
+		  : timespan (timespan)
+		  , graph_builder (graph_builder)
+		  , done (false)
+		  , active (false)
+		  , offset (0)
+		  , samples (0)
+		  , last_cycle (false)
+		  , post_processed (false)
+			{}
+
+		ExportTimespanPtr                     timespan;
+		boost::shared_ptr<ExportGraphBuilder> graph_builder;
+		bool                                  done;
+
+		/* set for each cycle */
+		bool        active;
+		samplecnt_t offset;
+		samplecnt_t samples;
+		bool        last_cycle;
+		bool        post_processed;
+	};
+
 	void start_timespan ();
 	int  process_timespan (samplecnt_t samples);
+	int  process_pass (samplepos_t position, samplecnt_t samples);
+	void process_pass_timespan (PassTimespan*);
 	int  post_process ();
+	void post_process_pass_timespan (PassTimespan*);
 	void finish_timespan ();
+	void finish_pass_timespan (PassTimespan&);
+
+	void handle_duplicate_format_extensions (TimespanBounds const&);
+	bool is_region_export (TimespanBounds const&) const;
+	void add_pass_timespan (ExportTimespanPtr, boost::shared_ptr<ExportGraphBuilder>, bool realtime);
 
-	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
 
+	std::vector<PassTimespan>                            pass_timespans;
+	std::vector<boost::shared_ptr<ExportGraphBuilder> >  pass_graph_builders; // graphs for all but the first, kept for reuse
+	std::vector<boost::function<void ()> >               pass_tasks;
+	std::vector<boost::function<void ()> >               pass_post_tasks;
+	ChannelData                                          pass_channel_data;
+	samplepos_t                                          pass_end;
+
 	PBD::ScopedConnection process_connection;
 	samplepos_t             process_position;
 
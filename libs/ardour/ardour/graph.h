@@ -29,8 +29,10 @@
 #include <boost/shared_ptr.hpp>
 
 #include <glib.h>
+#include <glibmm/threads.h>
 
 #include "pbd/semutils.h"
+#include "pbd/ws_deque.h"
 
 #include "ardour/libardour_visibility.h"
 #include "ardour/types.h"
@@ -63,7 +65,7 @@ public:
 	void dump (int chain);
 	void dec_ref();
 
-	void helper_thread();
+	void helper_thread (uint32_t thread_id);
 
 	int process_routes (pframes_t nframes, samplepos_t start_sample, samplepos_t end_sample, int declick,
 	                    bool& need_butler);
@@ -86,9 +88,17 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 	void restart_cycle();
-	bool run_one();
+	bool run_one (uint32_t thread_id);
+	bool run_one_ws (uint32_t thread_id);
 	void main_thread();
 	void prep();
+	void update_critical_path (int chain);
+
+	struct WorkQueue;
+
+	GraphNode* ws_find_work (uint32_t thread_id);
+	GraphNode* ws_claim_seed (WorkQueue*);
+	void ws_wakeup (int n_tasks);
 
 	node_list_t _nodes_rt[2];
 
@@ -97,6 +107,29 @@ private:
 	std::vector<GraphNode *> _trigger_queue;
 	pthread_mutex_t          _trigger_mutex;
 
+	/* work-stealing scheduler.
+	 *
+	 * Every DSP thread owns a deque for the nodes it triggers, and
+	 * a slice of the initial trigger list. Idle threads steal from
+	 * the other threads' deques before going to sleep.
+	 */
+	struct WorkQueue {
+		WorkQueue ();
+		PBD::WorkStealingDeque<GraphNode*> deque;
+		volatile gint seed_pos;
+		volatile gint seed_end;
+	};
+
+	static Glib::Threads::Private<WorkQueue> _thread_work_queue;
+
+	std::vector<WorkQueue*>  _work_queues;
+	/** initial nodes (for each chain), grouped by the node they feed */
+	std::vector<GraphNode*>  _init_trigger_seeds[2];
+	/** true if the current cycle uses the work-stealing scheduler */
+	volatile gint            _work_stealing;
+	/** number of nodes pushed to _trigger_queue because a deque was full */
+	volatile gint            _trigger_overflow;
+
 	PBD::Semaphore _execution_sem;
 
 	/** Signalled to start a run of the graph for a process callback */
@@ -24,6 +24,7 @@
 #include <list>
 #include <set>
 #include <vector>
+#include <stdint.h>
 
 #include <boost/shared_ptr.hpp>
 
@@ -50,6 +51,11 @@ class LIBARDOUR_API GraphNode
 
 	virtual void process();
 
+	/** Update the moving average of the time taken by process() */
+	void update_cost (int64_t usec);
+
+	float priority () const { return _priority; }
+
     private:
 	friend class Graph;
 
@@ -61,6 +67,11 @@ class LIBARDOUR_API GraphNode
 	gint _refcount;
 	/** The number of nodes that we directly feed us (one count for each chain) */
 	gint _init_refcount[2];
+
+	/** Moving average of the time taken by process() [usec] */
+	float _cost;
+	/** Cost of the most expensive path from this node to the end of the graph [usec] */
+	float _priority;
 };
 
 }
@@ -33,6 +33,10 @@ extern "C" {
 	LIBARDOUR_API void  x86_sse_mix_buffers_no_gain  (float * dst, const float * src, uint32_t nframes);
 }
 
+LIBARDOUR_API void  x86_sse_mix_buffers_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_copy_vector_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_crossfade_buffers           (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+
 extern "C" {
 /* AVX functions */
 	LIBARDOUR_API float x86_sse_avx_compute_peak         (const float * buf, uint32_t nsamples, float current);
@@ -45,6 +49,10 @@ extern "C" {
 LIBARDOUR_API void  x86_sse_find_peaks                 (const float * buf, uint32_t nsamples, float *min, float *max);
 LIBARDOUR_API void  x86_sse_avx_find_peaks             (const float * buf, uint32_t nsamples, float *min, float *max);
 
+LIBARDOUR_API void  x86_sse_avx_mix_buffers_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_copy_vector_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+LIBARDOUR_API void  x86_sse_avx_crossfade_buffers           (float * dst, const float * src, const float * gain, float scale, uint32_t nframes);
+
 /* debug wrappers for SSE functions */
 
 LIBARDOUR_API float debug_compute_peak               (const ARDOUR::Sample * buf, ARDOUR::pframes_t nsamples, float current);
@@ -74,4 +82,8 @@ LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample * dst, con
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector				  (ARDOUR::Sample * dst, const ARDOUR::Sample * src, ARDOUR::pframes_t nframes);
 
+LIBARDOUR_API void  default_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_copy_vector_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, ARDOUR::pframes_t nframes);
+LIBARDOUR_API void  default_crossfade_buffers           (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, ARDOUR::pframes_t nframes);
+
 #endif /* __ardour_mix_h__ */
@@ -24,6 +24,7 @@
 #include <set>
 #include <map>
 #include <list>
+#include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/enable_shared_from_this.hpp>
 #include <boost/utility.hpp>
@@ -197,6 +198,11 @@ public:
 	XMLNode& get_state ();
 	virtual int set_state (const XMLNode&, int version);
 	XMLNode& get_template ();
+	/** @return a copy of get_state(). If @a reuse is true and nothing
+	 * changed since the previous call, the state that call generated is
+	 * copied instead of being built again. Used for session saves.
+	 */
+	XMLNode& cached_state (bool reuse);
 
 	PBD::Signal1<void,bool> InUse;
 	PBD::Signal0<void>      ContentsChanged;
@@ -251,6 +257,7 @@ public:
 
   protected:
 	friend class Session;
+	friend class Region; /* invalidate_region_index (), invalidate_state_cache () */
 
   protected:
     class RegionReadLock : public Glib::Threads::RWLock::ReaderLock {
@@ -265,6 +272,8 @@ public:
                     : Glib::Threads::RWLock::WriterLock (pl->region_lock)
                     , playlist (pl)
                     , block_notify (do_block_notify) {
+                    playlist->invalidate_region_index ();
+                    playlist->invalidate_state_cache ();
                     if (block_notify) {
                             playlist->delay_notifications();
                     }
@@ -413,6 +422,35 @@ public:
 	void coalesce_and_check_crossfades (std::list<Evoral::Range<samplepos_t> >);
 	boost::shared_ptr<RegionList> find_regions_at (samplepos_t);
 
+	/* An index of the region list, sorted by position and augmented with
+	 * the maximum end of each implicit subtree, which turns range queries
+	 * on large playlists into O(log n + k) lookups. It is rebuilt lazily
+	 * after the region list or any region's bounds have changed.
+	 */
+	struct RegionIndexEntry {
+		samplepos_t first;
+		samplepos_t max_last;
+		boost::shared_ptr<Region> region;
+	};
+
+	mutable Glib::Threads::Mutex          _region_index_lock;
+	mutable std::vector<RegionIndexEntry> _region_index;
+	mutable gint                          _region_index_dirty;
+
+	void invalidate_region_index () const { g_atomic_int_set (&_region_index_dirty, 1); }
+	bool update_region_index () const;
+	void rebuild_region_index () const;
+	samplepos_t build_region_index_tree (size_t lo, size_t hi) const;
+	void region_index_touched (size_t lo, size_t hi, samplepos_t start, samplepos_t end, RegionList&) const;
+	bool regions_touched_indexed (samplepos_t start, samplepos_t end, RegionList&) const;
+
+	/* get_state() as of the last cached_state(), without extra XML */
+	XMLNode* _cached_state;
+	gint     _cached_state_serial;
+	mutable gint _state_serial;
+
+	void invalidate_state_cache () const { g_atomic_int_inc (&_state_serial); }
+
 	samplepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 };
 
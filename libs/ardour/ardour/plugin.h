@@ -274,7 +274,7 @@ class LIBARDOUR_API Plugin : public PBD::StatefulDestructible, public Latent
 	/** Emitted when a parameter is altered by something outside of our
 	 * control, most typically a Plugin GUI/editor
 	 */
-	PBD::Signal2<void, uint32_t, float> ParameterChangedExternally;
+	PBD::RTSignal2<void, uint32_t, float> ParameterChangedExternally;
 
 	virtual bool configure_io (ChanCount /*in*/, ChanCount /*out*/) { return true; }
 
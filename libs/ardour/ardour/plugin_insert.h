@@ -35,6 +35,7 @@
 #include "ardour/plugin.h"
 #include "ardour/processor.h"
 #include "ardour/readonly_control.h"
+#include "ardour/rt_tasklist.h"
 #include "ardour/sidechain.h"
 #include "ardour/automation_control.h"
 
@@ -121,6 +122,7 @@ public:
 	bool reset_map (bool emit = true);
 	bool sanitize_maps ();
 	bool check_inplace ();
+	bool check_replicas_independent (bool no_inplace) const;
 	bool configured () const { return _configured; }
 
 	// these are ports visible on the outside
@@ -345,6 +347,7 @@ private:
 
 	bool _configured;
 	bool _no_inplace;
+	bool _replicas_independent;
 	bool _strict_io;
 	bool _custom_cfg;
 	bool _maps_from_state;
@@ -365,6 +368,29 @@ private:
 	void automate_and_run (BufferSet& bufs, samplepos_t start, samplepos_t end, double speed, pframes_t nframes);
 	void connect_and_run (BufferSet& bufs, samplepos_t start, samplecnt_t end, double speed, pframes_t nframes, samplecnt_t offset, bool with_auto);
 	void bypass (BufferSet& bufs, pframes_t nframes);
+
+	/** arguments shared by all replicas that are run in parallel,
+	 * set by connect_and_run() for the current cycle
+	 */
+	struct ReplicaCycle {
+		BufferSet*         bufs;
+		samplepos_t        start;
+		samplepos_t        end;
+		double             speed;
+		PinMappings const* in_map;
+		PinMappings const* out_map;
+		pframes_t          nframes;
+		samplecnt_t        offset;
+	};
+
+	void run_replica (uint32_t pc);
+	void setup_replica_tasks ();
+
+	ReplicaCycle         _replica_cycle;
+	RTTaskList::TaskList _replica_tasks; // one per replica, built by configure_io()
+	RTTaskList::Batch    _replica_batch;
+	gint                 _replica_failed;
+
 	void inplace_silence_unconnected (BufferSet&, const PinMappings&, samplecnt_t nframes, samplecnt_t offset) const;
 
 	void create_automatable_parameters ();
@@ -27,6 +27,7 @@
 
 #include <stdint.h>
 
+#include <boost/function.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include "pbd/rcu.h"
@@ -177,9 +178,51 @@ class LIBARDOUR_API PortManager
 	boost::shared_ptr<Port> register_port (DataType type, const std::string& portname, bool input, bool async = false, PortFlags extra_flags = PortFlags (0));
 	void port_registration_failure (const std::string& portname);
 
-	/** List of ports to be used between ::cycle_start() and ::cycle_end()
+	/** List of ports to be used between ::cycle_start() and ::cycle_end(),
+	 * valid for the RCUEpoch::ReadSection of the process callback.
 	 */
-	boost::shared_ptr<Ports> _cycle_ports;
+	Ports* _cycle_ports;
+
+	/** Flat per-cycle view of a Ports map, rebuilt after ports change
+	 * so that the process callback neither walks the map nor allocates.
+	 *
+	 * Ports are partitioned into 'light' work (MIDI timestamp scaling,
+	 * flagging outputs) which runs as a single sequential task and
+	 * 'heavy' work (audio resampling) with one task per port.
+	 */
+	struct CyclePorts {
+		/** the map this was built from. Not owned, so that an outdated
+		 * plan does not keep unregistered ports alive.
+		 */
+		Ports const*           ports;
+		boost::weak_ptr<Ports> ports_alive;
+		std::vector<Port*> all;
+
+		std::vector<Port*> start_light;
+		std::vector<Port*> start_heavy; ///< audio inputs
+		std::vector<Port*> end_light;
+		std::vector<Port*> end_heavy;   ///< audio outputs
+
+		/* same type as RTTaskList::TaskList, empty if parallel
+		 * processing is not worth it.
+		 */
+		std::vector<boost::function<void ()> > start_tasks;
+		std::vector<boost::function<void ()> > end_tasks;
+	};
+
+	SerializedRCUManager<CyclePorts> _cycle_plans;
+	/** valid for the RCUEpoch::ReadSection of the process callback, 0 if
+	 * the plan does not (yet) match _cycle_ports.
+	 */
+	CyclePorts* _cycle_plan;
+	pframes_t   _cycle_plan_nframes;
+	/** set when ports change, the plan is rebuilt by the next
+	 * ::update_cycle_ports() from a non-realtime thread.
+	 */
+	gint        _cycle_plan_dirty;
+
+	void update_cycle_ports ();
+	void run_cycle_end (pframes_t nframes, Session* s);
 
 	void silence (pframes_t nframes, Session *s = 0);
 	void silence_outputs (pframes_t nframes);
@@ -0,0 +1,81 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __ardour_read_batch_h__
+#define __ardour_read_batch_h__
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+class ReadBatchTest;
+
+namespace ARDOUR {
+
+class AudioFileSource;
+
+/** The file reads of a butler refill pass.
+ *
+ * Tracks add the source ranges their next refill will read. submit()
+ * sorts them by file and offset, merges adjacent and overlapping ones
+ * (e.g. the channels of an interleaved file, or regions sharing a source)
+ * and asks the sources to prefetch them. The kernel then reads ahead
+ * while the refill threads are busy with other tracks, and the
+ * synchronous reads of the refill mostly hit the page cache.
+ */
+class LIBARDOUR_API ReadBatch
+{
+public:
+	ReadBatch () {}
+
+	void add (boost::shared_ptr<AudioFileSource>, samplepos_t start, samplecnt_t cnt);
+
+	/** prefetch all ranges, and clear the batch */
+	void submit ();
+	void clear () { _requests.clear (); }
+
+	size_t size () const { return _requests.size (); }
+
+private:
+	friend class ::ReadBatchTest;
+
+	struct Request {
+		Request (boost::shared_ptr<AudioFileSource> s, samplepos_t st, samplecnt_t c)
+			: source (s), start (st), cnt (c) {}
+
+		boost::shared_ptr<AudioFileSource> source;
+		samplepos_t start;
+		samplecnt_t cnt;
+	};
+
+	struct RequestSorter {
+		bool operator() (Request const&, Request const&) const;
+	};
+
+	std::vector<Request> _requests;
+
+	/** sort the requests, and merge adjacent and overlapping ones */
+	void coalesce ();
+};
+
+} // namespace ARDOUR
+
+#endif /* __ardour_read_batch_h__ */
@@ -283,6 +283,9 @@ public:
 	XMLNode&         get_state ();
 	virtual int      set_state (const XMLNode&, int version);
 
+	/** @return the Extra node that get_state() adds, or 0 */
+	XMLNode const*   extra_xml_node () const { return _extra_xml; }
+
 	virtual boost::shared_ptr<Region> get_parent() const;
 
 	uint64_t layering_index () const { return _layering_index; }
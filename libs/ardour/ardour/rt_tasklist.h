@@ -19,9 +19,10 @@
 #ifndef _ardour_rt_tasklist_h_
 #define _ardour_rt_tasklist_h_
 
-#include <list>
+#include <vector>
 #include <boost/function.hpp>
 
+#include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
 
 #include "ardour/libardour_visibility.h"
@@ -37,12 +38,43 @@ public:
 	RTTaskList ();
 	~RTTaskList ();
 
-	// TODO use dedicated allocator of a boost::intrusive::list
-	typedef std::list<boost::function<void ()> > TaskList;
+	typedef std::vector<boost::function<void ()> > TaskList;
 
-	/** process tasks in list in parallel, wait for them to complete */
+	/** Synchronization state of one list being processed.
+	 *
+	 * Owners that process the same list every cycle keep one of
+	 * these with the list, see process (TaskList const&, Batch&).
+	 */
+	class LIBARDOUR_API Batch
+	{
+	public:
+		Batch ();
+
+	private:
+		friend class RTTaskList;
+
+		TaskList const* _tasks;
+		gint            _next;    ///< index of the next task to claim
+		gint            _pending; ///< helpers still working, plus the caller
+		PBD::Semaphore  _done;
+	};
+
+	/** process tasks in list in parallel, wait for them to complete.
+	 *
+	 * The calling thread takes part in processing. Tasks are
+	 * queued by reference, the list is not copied. Calls are
+	 * serialized.
+	 */
 	void process (TaskList const&);
 
+	/** process tasks in list in parallel, wait for them to complete.
+	 *
+	 * Unlike process (TaskList const&) this neither locks nor
+	 * allocates, and may be called concurrently from several
+	 * threads (e.g. the process graph), each with its own batch.
+	 */
+	void process (TaskList const&, Batch&);
+
 private:
 	gint _threads_active;
 	std::vector<pthread_t> _threads;
@@ -50,17 +82,17 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 
-	void process_tasklist ();
+	static void run_batch (Batch&);
 
 	static void* _thread_run (void *arg);
 	void run ();
 
 	Glib::Threads::Mutex _process_mutex;
-	Glib::Threads::Mutex _tasklist_mutex;
-	PBD::Semaphore _task_run_sem;
-	PBD::Semaphore _task_end_sem;
+	Batch                _process_batch;
+	PBD::Semaphore       _task_run_sem;
 
-	TaskList _tasklist;
+	/* one entry per helper thread woken up, each wakeup consumes one */
+	PBD::MPMCQueue<Batch*> _batches;
 };
 
 } // namespace ARDOUR
@@ -31,6 +31,9 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t)	(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)		(ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)			    (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef void  (*mix_buffers_with_gain_curve_t)	(ARDOUR::Sample *, const ARDOUR::Sample *, const float *, float, pframes_t);
+	typedef void  (*copy_vector_with_gain_curve_t)	(ARDOUR::Sample *, const ARDOUR::Sample *, const float *, float, pframes_t);
+	typedef void  (*crossfade_buffers_t)		(ARDOUR::Sample *, const ARDOUR::Sample *, const float *, float, pframes_t);
 
 	LIBARDOUR_API extern compute_peak_t		compute_peak;
 	LIBARDOUR_API extern find_peaks_t               find_peaks;
@@ -38,6 +41,11 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t	mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t	mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t			copy_vector;
+
+	/* fused region read kernels: per-sample gain curve times a constant scale */
+	LIBARDOUR_API extern mix_buffers_with_gain_curve_t	mix_buffers_with_gain_curve; ///< dst += src * gain * scale
+	LIBARDOUR_API extern copy_vector_with_gain_curve_t	copy_vector_with_gain_curve; ///< dst = src * gain * scale
+	LIBARDOUR_API extern crossfade_buffers_t		crossfade_buffers;           ///< dst = dst * (1 - gain) + src * gain * scale
 }
 
 #endif /* __ardour_runtime_functions_h__ */
@@ -1427,10 +1427,16 @@ private:
 	friend class    StateProtector;
 	gint            _suspend_save; /* atomic */
 	volatile bool   _save_queued;
+	bool            _incremental_save;
+	Glib::Threads::Thread* _pending_state_writer;
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
 	Glib::Threads::Mutex peak_cleanup_lock;
 
+	int  write_state_file (XMLTree&, std::string const& tmp_path, std::string const& xml_path);
+	void write_pending_state (XMLTree*, std::string tmp_path, std::string xml_path);
+	void wait_for_pending_state ();
+
 	int        load_options (const XMLNode&);
 	int        load_state (std::string snapshot_name);
 	static int parse_stateful_loading_version (const std::string&);
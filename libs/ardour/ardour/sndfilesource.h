@@ -59,6 +59,7 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	int update_header (samplepos_t when, struct tm&, time_t);
 	int flush_header ();
 	void flush ();
+	void prefetch (samplepos_t start, samplecnt_t cnt);
 
 	samplepos_t natural_position () const;
 
@@ -92,8 +93,22 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
 
+	/* file descriptor of _sndfile (owned by libsndfile), the data
+	 * layout for prefetch() and the state of preallocation and
+	 * write-behind for recording.
+	 */
+	int   _fd;
+	off_t _data_offset; ///< byte offset of the sample data, -1 if unknown
+	off_t _frame_bytes; ///< 0 if not known, or not stored as plain PCM
+	off_t _preallocated;
+	off_t _writeback_start;
+	off_t _writeback_end;
+
 	void init_sndfile ();
 	int open();
+	void locate_sample_data ();
+	void write_behind ();
+	void release_preallocation ();
 	int setup_broadcast_info (samplepos_t when, struct tm&, time_t);
 	void file_closed ();
 
@@ -67,9 +67,24 @@ class LIBARDOUR_API SourceFactory {
         static Glib::Threads::Cond                       PeaksToBuild;
         static Glib::Threads::Mutex                      peak_building_lock;
 	static std::list< boost::weak_ptr<AudioSource> > files_with_peaks;
+	/** sources with a peakfile whose levels are missing, handled once files_with_peaks is empty */
+	static std::list< boost::weak_ptr<AudioSource> > files_with_peak_levels;
 
 	static int peak_work_queue_length ();
 	static int setup_peakfile (boost::shared_ptr<Source>, bool async);
+
+	/** move a source that is waiting for its peakfile to the front of
+	 * the queue, e.g. because it is visible in the editor.
+	 */
+	static void prioritize_peakfile (boost::shared_ptr<Source>);
+
+	/** @param done number of sources whose peakfile was set up since the queue was last empty
+	 *  @param total number of sources that were queued since the queue was last empty
+	 */
+	static void peak_work_progress (uint32_t& done, uint32_t& total);
+
+	/** drop all queued sources, peakfiles that are currently being built are completed */
+	static void cancel_peak_work ();
 };
 
 }
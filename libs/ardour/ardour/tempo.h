@@ -26,8 +26,11 @@
 #include <cmath>
 #include <glibmm/threads.h>
 
+#include <boost/shared_ptr.hpp>
+
 #include "pbd/undo.h"
 #include "pbd/enum_convert.h"
+#include "pbd/rcu.h"
 
 #include "pbd/stateful.h"
 #include "pbd/statefuldestructible.h"
@@ -593,6 +596,32 @@ private:
 	samplecnt_t                    _sample_rate;
 	mutable Glib::Threads::RWLock lock;
 
+	/** An immutable copy of the solved map, used for lookups which must
+	 * not wait for the lock (the process thread). Sections are shared
+	 * between successive snapshots until the map changes.
+	 */
+	struct Snapshot {
+		void set (const Metrics& metrics);
+
+		double pulse_at_minute (const double& minute) const;
+		double minute_at_pulse (const double& pulse) const;
+
+		std::vector<boost::shared_ptr<MetricSection> > sections;
+		/** the sections in map order, for use with the *_locked() methods */
+		Metrics metrics;
+		/** active tempo sections in map order, and their positions for binary search */
+		std::vector<const TempoSection*> tempi;
+		std::vector<double>              tempo_minutes;
+		std::vector<double>              tempo_pulses;
+	};
+
+	SerializedRCUManager<Snapshot> _snapshot;
+	gint                           _snapshot_stale;
+
+	void mark_snapshot_stale ();
+	void publish_snapshot ();
+	const Snapshot* read_snapshot (boost::shared_ptr<Snapshot>& keep) const;
+
 	void recompute_tempi (Metrics& metrics);
 	void recompute_meters (Metrics& metrics);
 	void recompute_map (Metrics& metrics, samplepos_t end = -1);
@@ -36,6 +36,7 @@ class Source;
 class Region;
 class DiskReader;
 class DiskWriter;
+class ReadBatch;
 class IO;
 class RecordEnableControl;
 class RecordSafeControl;
@@ -133,6 +134,8 @@ public:
 	float playback_buffer_load () const;
 	float capture_buffer_load () const;
 	int do_refill ();
+	int do_refill (Sample* mixdown_buffer, gain_t* gain_buffer);
+	void add_read_requests (ReadBatch&) const;
 	int do_flush (RunContext, bool force = false);
 	void set_pending_overwrite (bool);
 	int seek (samplepos_t, bool complete_refill = false);
@@ -164,8 +164,22 @@ ARDOUR::samplecnt_t
 AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, samplepos_t start,
 		     samplecnt_t cnt, unsigned chan_n)
 {
-	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channel %4, regions %5 mixdown @ %6 gain @ %7\n",
-							   name(), start, cnt, chan_n, regions.size(), mixdown_buffer, gain_buffer));
+	return read_channels (&buf, 1, mixdown_buffer, gain_buffer, start, cnt, chan_n);
+}
+
+/** Read several channels at once. Which parts of which regions need to be
+ *  read is only worked out once for all channels.
+ *
+ *  @param bufs Array of @param n_chans buffers, bufs[n] receives channel first_chan + n.
+ *  @param start Start position in session samples.
+ *  @param cnt Number of samples to read.
+ */
+ARDOUR::samplecnt_t
+AudioPlaylist::read_channels (Sample **bufs, uint32_t n_chans, Sample *mixdown_buffer, float *gain_buffer, samplepos_t start,
+			      samplecnt_t cnt, uint32_t first_chan)
+{
+	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channels %4..%5, regions %6 mixdown @ %7 gain @ %8\n",
+							   name(), start, cnt, first_chan, first_chan + n_chans - 1, regions.size(), mixdown_buffer, gain_buffer));
 
 	/* optimizing this memset() away involves a lot of conditionals
 	   that may well cause more of a hit due to cache misses
@@ -180,7 +194,9 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 	   zeroed.
 	*/
 
-	memset (buf, 0, sizeof (Sample) * cnt);
+	for (uint32_t n = 0; n < n_chans; ++n) {
+		memset (bufs[n], 0, sizeof (Sample) * cnt);
+	}
 
 	/* this function is never called from a realtime thread, so
 	   its OK to block (for short intervals).
@@ -246,11 +262,13 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, sa
 
 	/* Now go backwards through the to_do list doing the actual reads */
 	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
-		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
-								   name(), i->region->name(), i->range.from,
-								   i->range.to - i->range.from + 1, (int) chan_n,
-								   buf, i->range.from - start));
-		i->region->read_at (buf + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, chan_n);
+		for (uint32_t n = 0; n < n_chans; ++n) {
+			DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
+									   name(), i->region->name(), i->range.from,
+									   i->range.to - i->range.from + 1, (int) (first_chan + n),
+									   bufs[n], i->range.from - start));
+			i->region->read_at (bufs[n] + i->range.from - start, mixdown_buffer, gain_buffer, i->range.from, i->range.to - i->range.from + 1, first_chan + n);
+		}
 	}
 
 	return cnt;
@@ -32,6 +32,7 @@
 #include "pbd/epa.h"
 #include "pbd/file_utils.h"
 #include "pbd/pthread_utils.h"
+#include "pbd/rcu.h"
 #include "pbd/stacktrace.h"
 #include "pbd/unknown_type.h"
 
@@ -220,6 +221,12 @@ AudioEngine::process_callback (pframes_t nframes)
 		return 0;
 	}
 
+	/* values obtained from SerializedRCUManager::rt_reader() during
+	 * this cycle (by this or any process thread) remain valid until
+	 * the end of the cycle.
+	 */
+	RCUEpoch::ReadSection rs;
+
 	/* The coreaudio-backend calls thread_init_callback() if
 	 * the hardware changes or pthread_self() changes.
 	 *
@@ -631,6 +638,7 @@ AudioEngine::set_session (Session *s)
 	if (_session) {
 
 		pframes_t blocksize = samples_per_cycle ();
+		RCUEpoch::ReadSection rs;
 
 		PortManager::cycle_start (blocksize);
 
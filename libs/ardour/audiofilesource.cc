@@ -161,6 +161,7 @@ AudioFileSource::~AudioFileSource ()
 	if (removable()) {
 		::g_unlink (_path.c_str());
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 }
 
@@ -245,6 +246,7 @@ AudioFileSource::mark_streaming_write_completed (const Lock& lock)
 int
 AudioFileSource::move_dependents_to_trash()
 {
+	remove_peak_levels ();
 	return ::g_unlink (_peakpath.c_str());
 }
 
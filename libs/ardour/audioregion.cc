@@ -581,22 +581,57 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 		return 0;
 	}
 
-	/* APPLY REGULAR GAIN CURVES AND SCALING TO mixdown_buffer */
+	/* APPLY GAIN, FADES AND MIX THE RESULT INTO buf.
+	 *
+	 * The envelope and the scale amplitude are applied by the kernels
+	 * that also mix (or copy) the data into buf, so the region body,
+	 * which is usually most of a read, takes a single pass over
+	 * mixdown_buffer. The fades reuse gain_buffer, so the body is done
+	 * first, and the envelope is applied up front to the (short) parts
+	 * of mixdown_buffer that the fades cover.
+	 */
+
+	bool const envelope = envelope_active ();
+	float const scale = _scale_amplitude;
 
-	if (envelope_active())  {
+	if (envelope) {
 		_envelope->curve().get_vector (internal_offset, internal_offset + to_read, gain_buffer, to_read);
 
-		if (_scale_amplitude != 1.0f) {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n] * _scale_amplitude;
+		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
+			mixdown_buffer[n] *= gain_buffer[n];
+		}
+		for (samplecnt_t n = max (fade_in_limit, fade_out_offset); n < fade_out_offset + fade_out_limit; ++n) {
+			mixdown_buffer[n] *= gain_buffer[n];
+		}
+	}
+
+	/* MIX OR COPY THE REGION BODY FROM mixdown_buffer INTO buf */
+
+	samplecnt_t const N = to_read - fade_in_limit - fade_out_limit;
+	if (N > 0) {
+		Sample* const dst = buf + fade_in_limit;
+		Sample const * const src = mixdown_buffer + fade_in_limit;
+
+		if (envelope) {
+			if (opaque ()) {
+				copy_vector_with_gain_curve (dst, src, gain_buffer + fade_in_limit, scale, N);
+			} else {
+				mix_buffers_with_gain_curve (dst, src, gain_buffer + fade_in_limit, scale, N);
 			}
-		} else {
-			for (samplecnt_t n = 0; n < to_read; ++n) {
-				mixdown_buffer[n] *= gain_buffer[n];
+		} else if (scale != 1.0f) {
+			if (opaque ()) {
+				memcpy (dst, src, N * sizeof (Sample));
+				apply_gain_to_buffer (dst, N, scale);
+			} else {
+				mix_buffers_with_gain (dst, src, N, scale);
 			}
+		} else if (opaque ()) {
+			DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Region %1 memcpy into buf @ %2 + %3, from mixdown buffer @ %4 + %5, len = %6 cnt was %7\n",
+									   name(), buf, fade_in_limit, mixdown_buffer, fade_in_limit, N, cnt));
+			memcpy (dst, src, N * sizeof (Sample));
+		} else {
+			mix_buffers_no_gain (dst, src, N);
 		}
-	} else if (_scale_amplitude != 1.0f) {
-		apply_gain_to_buffer (mixdown_buffer, to_read, _scale_amplitude);
 	}
 
 	/* APPLY FADES TO THE DATA IN mixdown_buffer AND MIX THE RESULTS INTO
@@ -622,9 +657,11 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 					buf[n] *= gain_buffer[n];
 				}
 
-				/* refill gain buffer with the fade in */
+				/* refill gain buffer with the fade in, and mix our
+				 * newly-read data in, with the fade */
 
 				_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
+				mix_buffers_with_gain_curve (buf, mixdown_buffer, gain_buffer, scale, fade_in_limit);
 
 			} else {
 
@@ -633,24 +670,20 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 				 */
 
 				_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
-
-				for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-					buf[n] *= 1 - gain_buffer[n];
-				}
+				crossfade_buffers (buf, mixdown_buffer, gain_buffer, scale, fade_in_limit);
 			}
 		} else {
+			/* Mix our newly-read data in, with the fade */
 			_fade_in->curve().get_vector (internal_offset, internal_offset + fade_in_limit, gain_buffer, fade_in_limit);
-		}
-
-		/* Mix our newly-read data in, with the fade */
-		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
-			buf[n] += mixdown_buffer[n] * gain_buffer[n];
+			mix_buffers_with_gain_curve (buf, mixdown_buffer, gain_buffer, scale, fade_in_limit);
 		}
 	}
 
 	if (fade_out_limit != 0) {
 
 		samplecnt_t const curve_offset = fade_interval_start - (_length - _fade_out->back()->when);
+		Sample* const dst = buf + fade_out_offset;
+		Sample const * const src = mixdown_buffer + fade_out_offset;
 
 		if (opaque()) {
 			if (_inverse_fade_out) {
@@ -658,13 +691,17 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 				_inverse_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
 
 				/* Fade the data from lower levels in */
-				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= gain_buffer[n];
+				for (samplecnt_t n = 0; n < fade_out_limit; ++n) {
+					dst[n] *= gain_buffer[n];
 				}
 
-				/* fetch the actual fade out */
+				/* fetch the actual fade out, and mix our data with
+				 * whatever was already there, with the fade out
+				 * applied to our data.
+				 */
 
 				_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
+				mix_buffers_with_gain_curve (dst, src, gain_buffer, scale, fade_out_limit);
 
 			} else {
 
@@ -674,33 +711,14 @@ AudioRegion::read_at (Sample *buf, Sample *mixdown_buffer, float *gain_buffer,
 				 */
 
 				_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
-
-				for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-					buf[m] *= 1 - gain_buffer[n];
-				}
+				crossfade_buffers (dst, src, gain_buffer, scale, fade_out_limit);
 			}
 		} else {
+			/* Mix our newly-read data with whatever was already there,
+			   with the fade out applied to our data.
+			*/
 			_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, gain_buffer, fade_out_limit);
-		}
-
-		/* Mix our newly-read data with whatever was already there,
-		   with the fade out applied to our data.
-		*/
-		for (samplecnt_t n = 0, m = fade_out_offset; n < fade_out_limit; ++n, ++m) {
-			buf[m] += mixdown_buffer[m] * gain_buffer[n];
-		}
-	}
-
-	/* MIX OR COPY THE REGION BODY FROM mixdown_buffer INTO buf */
-
-	samplecnt_t const N = to_read - fade_in_limit - fade_out_limit;
-	if (N > 0) {
-		if (opaque ()) {
-			DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Region %1 memcpy into buf @ %2 + %3, from mixdown buffer @ %4 + %5, len = %6 cnt was %7\n",
-									   name(), buf, fade_in_limit, mixdown_buffer, fade_in_limit, N, cnt));
-			memcpy (buf + fade_in_limit, mixdown_buffer + fade_in_limit, N * sizeof (Sample));
-		} else {
-			mix_buffers_no_gain (buf + fade_in_limit, mixdown_buffer + fade_in_limit, N);
+			mix_buffers_with_gain_curve (dst, src, gain_buffer, scale, fade_out_limit);
 		}
 	}
 
@@ -49,6 +49,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "pbd/compose.h"
 #include "pbd/file_utils.h"
 #include "pbd/scoped_file_descriptor.h"
 #include "pbd/xml++.h"
@@ -76,6 +77,9 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+/* each level of the peak pyramid holds one peak per this many peaks of the level below */
+static const samplecnt_t peak_level_ratio = 16;
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _length (0)
@@ -89,7 +93,10 @@ AudioSource::AudioSource (Session& s, const string& name)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_read_fpp (_FPP)
+	, _peak_levels_pending (0)
 {
+	setup_peak_levels ();
 }
 
 AudioSource::AudioSource (Session& s, const XMLNode& node)
@@ -105,7 +112,11 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _last_scale (0.0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
+	, _last_read_fpp (_FPP)
+	, _peak_levels_pending (0)
 {
+	setup_peak_levels ();
+
 	if (set_state (node, Stateful::loading_state_version)) {
 		throw failed_constructor();
 	}
@@ -124,6 +135,8 @@ AudioSource::~AudioSource ()
 		_peakfile_fd = -1;
 	}
 
+	close_peak_levels ();
+
 	delete [] peak_leftovers;
 }
 
@@ -225,7 +238,18 @@ AudioSource::rename_peakfile (string newpath)
 		}
 	}
 
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		string const oldlevel = peak_level_path (oldpath, l);
+		if (Glib::file_test (oldlevel, Glib::FILE_TEST_EXISTS)) {
+			if (g_rename (oldlevel.c_str(), peak_level_path (newpath, l).c_str()) != 0) {
+				/* the level will be rebuilt from the main peakfile */
+				::g_unlink (oldlevel.c_str());
+			}
+		}
+	}
+
 	_peakpath = newpath;
+	setup_peak_levels ();
 
 	return 0;
 }
@@ -301,7 +325,37 @@ AudioSource::initialize_peakfile (const string& audio_path, const bool in_sessio
 		}
 	}
 
-	if (!empty() && !_peaks_built && _build_missing_peakfiles && _build_peakfiles) {
+	setup_peak_levels ();
+
+	if (_peaks_built) {
+		/* check the coarser levels, they need to be at least as recent as the main peakfile */
+		bool levels_built = true;
+
+		for (uint32_t l = 0; l < n_peak_levels; ++l) {
+			PeakLevel& pl (_peak_levels[l]);
+			GStatBuf level_stat;
+
+			pl.built = false;
+			pl.byte_max = 0;
+
+			if (g_stat (pl.path.c_str(), &level_stat) == 0
+			    && level_stat.st_size >= (off_t) ((length(_timeline_position) / pl.fpp) * sizeof (PeakData))
+			    && level_stat.st_mtime + 6 >= statbuf.st_mtime) {
+				pl.built = true;
+				pl.byte_max = level_stat.st_size;
+			} else {
+				levels_built = false;
+			}
+		}
+
+		if (!levels_built && _build_peakfiles) {
+			/* this only needs the peakfile, leave it to the peak
+			 * threads (see SourceFactory::setup_peakfile()).
+			 */
+			g_atomic_int_set (&_peak_levels_pending, 1);
+		}
+
+	} else if (!empty() && _build_missing_peakfiles && _build_peakfiles) {
 		build_peaks_from_scratch ();
 	}
 
@@ -329,16 +383,54 @@ AudioSource::write (Sample *dst, samplecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	/* use the coarsest complete level of the peak pyramid that still
+	 * has at least one stored peak per visual peak.
+	 */
+	samplecnt_t fpp = _FPP;
+	string path;
+
+	{
+		Glib::Threads::Mutex::Lock lm (_lock);
+
+		for (uint32_t l = 0; l < n_peak_levels; ++l) {
+			PeakLevel const& pl (_peak_levels[l]);
+			if (pl.fpp > samples_per_visual_peak || !pl.built) {
+				break;
+			}
+			fpp = pl.fpp;
+			path = pl.path;
+		}
+
+		if (fpp != _last_read_fpp) {
+			/* the cached peaks were read from another level */
+			_first_run = true;
+			_last_read_fpp = fpp;
+		}
+	}
+
+	if (path.empty ()) {
+		return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	}
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Reading peaks from level %1 (%2 samples per peak)\n", path, fpp));
+	return read_peaks_from_peakfile (path, peaks, npeaks, start, cnt, samples_per_visual_peak, fpp);
+}
+
+int
+AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
+				  double samples_per_visual_peak, samplecnt_t samples_per_file_peak) const
+{
+	return read_peaks_from_peakfile (_peakpath, peaks, npeaks, start, cnt, samples_per_visual_peak, samples_per_file_peak);
 }
 
-/** @param peaks Buffer to write peak data.
+/** @param path Peak file to read, the main peakfile or one of its levels.
+ *  @param peaks Buffer to write peak data.
  *  @param npeaks Number of peaks to write.
  */
 
 int
-AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
-				  double samples_per_visual_peak, samplecnt_t samples_per_file_peak) const
+AudioSource::read_peaks_from_peakfile (const string& path, PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt,
+				       double samples_per_visual_peak, samplecnt_t samples_per_file_peak) const
 {
 	Glib::Threads::Mutex::Lock lm (_lock);
 	double scale;
@@ -359,12 +451,12 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 	GStatBuf statbuf;
 
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (path.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), path, strerror (errno)) << endmsg;
 		return -1;
 	}
 
-	if (!_captured_for.empty()) {
+	if (!_captured_for.empty() && path == _peakpath) {
 
 		/* _captured_for is only set after a capture pass is
 		 * complete. so we know that capturing is finished for this
@@ -381,12 +473,12 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		const off_t expected_file_size = (_length / (double) samples_per_file_peak) * sizeof (PeakData);
 
 		if (statbuf.st_size < expected_file_size) {
-			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), _peakpath, expected_file_size, statbuf.st_size) << endmsg;
+			warning << string_compose (_("peak file %1 is truncated from %2 to %3"), path, expected_file_size, statbuf.st_size) << endmsg;
 			lm.release(); // build_peaks_from_scratch() takes _lock
 			const_cast<AudioSource*>(this)->build_peaks_from_scratch ();
 			lm.acquire ();
-			if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), _peakpath, strerror (errno)) << endmsg;
+			if (g_stat (path.c_str(), &statbuf) != 0) {
+				error << string_compose (_("Cannot open peakfile @ %1 for size check (%2) after rebuild"), path, strerror (errno)) << endmsg;
 			}
 			if (statbuf.st_size < expected_file_size) {
 				fatal << "peak file is still truncated after rebuild" << endmsg;
@@ -395,10 +487,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (path.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), path, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -467,13 +559,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
@@ -484,13 +576,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), path) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
@@ -562,13 +654,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			map_handle = CreateFileMapping(file_handle, NULL, PAGE_READONLY, 0, 0, NULL);
 			if (map_handle == NULL) {
-				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not create file mapping for peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
 			view_handle = MapViewOfFile(map_handle, FILE_MAP_READ, 0, read_map_off, map_length);
 			if (view_handle == NULL) {
-				error << string_compose (_("map failed - could not map peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not map peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
@@ -579,13 +671,13 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 			err_flag = UnmapViewOfFile (view_handle);
 			err_flag = CloseHandle(map_handle);
 			if(!err_flag) {
-				error << string_compose (_("unmap failed - could not unmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("unmap failed - could not unmap peakfile %1."), path) << endmsg;
 				return -1;
 			}
 #else
 			addr = (char*) mmap (0, map_length, PROT_READ, MAP_PRIVATE, sfd, read_map_off);
 			if (addr ==  MAP_FAILED) {
-				error << string_compose (_("map failed - could not mmap peakfile %1."), _peakpath) << endmsg;
+				error << string_compose (_("map failed - could not mmap peakfile %1."), path) << endmsg;
 				return -1;
 			}
 
@@ -730,6 +822,9 @@ AudioSource::build_peaks_from_scratch ()
 			goto out;
 		}
 
+		/* start the coarser levels from scratch as well */
+		open_peak_levels (true);
+
 		samplecnt_t current_sample = 0;
 		samplecnt_t cnt = _length;
 
@@ -781,6 +876,7 @@ AudioSource::build_peaks_from_scratch ()
 	if (ret) {
 		DEBUG_TRACE (DEBUG::Peaks, string_compose("Could not write peak data, attempting to remove peakfile %1\n", _peakpath));
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 
 	return ret;
@@ -796,6 +892,7 @@ AudioSource::close_peakfile ()
 	}
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
+		remove_peak_levels ();
 	}
 	_peaks_built = false;
 	return 0;
@@ -812,6 +909,8 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	open_peak_levels (false);
 	return 0;
 }
 
@@ -823,6 +922,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 			close (_peakfile_fd);
 			_peakfile_fd = -1;
 		}
+		close_peak_levels ();
 		return;
 	}
 
@@ -830,14 +930,21 @@ AudioSource::done_with_peakfile_writes (bool done)
 		compute_and_write_peaks (0, 0, 0, true, false, _FPP);
 	}
 
+	/* write the partial peaks at the end of each level */
+	bool const levels_ok = (flush_peak_levels () == 0);
+
 	if (done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
+		for (uint32_t l = 0; l < n_peak_levels; ++l) {
+			_peak_levels[l].built = levels_ok && _peak_levels[l].fd >= 0;
+		}
 		PeaksReady (); /* EMIT SIGNAL */
 	}
 
 	close (_peakfile_fd);
 	_peakfile_fd = -1;
+	close_peak_levels ();
 }
 
 /** @param first_sample Offset from the source start of the first sample to
@@ -899,6 +1006,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 			_peak_byte_max = max (_peak_byte_max, (off_t) (byte + sizeof(PeakData)));
 
+			if (fpp == _FPP && accumulate_peak_levels (0, &x, peak_leftover_sample / fpp, 1)) {
+				return -1;
+			}
+
 			{
 				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 				PeakRangeReady (peak_leftover_sample, peak_leftover_cnt); /* EMIT SIGNAL */
@@ -1027,6 +1138,10 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 	_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
 
+	if (fpp == _FPP && accumulate_peak_levels (0, peakbuf.get(), first_sample / fpp, peaks_computed)) {
+		return -1;
+	}
+
 	if (samples_done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		PeakRangeReady (first_sample, samples_done); /* EMIT SIGNAL */
@@ -1058,6 +1173,263 @@ AudioSource::truncate_peakfile ()
 						 _peakpath, _peak_byte_max, errno) << endmsg;
 		}
 	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_levels[l]);
+		if (pl.fd >= 0 && lseek (pl.fd, 0, SEEK_END) > pl.byte_max) {
+			if (ftruncate (pl.fd, pl.byte_max)) {
+				/* the level is still usable, it is just larger than required */
+			}
+		}
+	}
+}
+
+/***********************************************************************
+  PEAK PYRAMID
+ ***********************************************************************/
+
+string
+AudioSource::peak_level_path (const string& peakpath, uint32_t level)
+{
+	samplecnt_t fpp = _FPP;
+	for (uint32_t l = 0; l <= level; ++l) {
+		fpp *= peak_level_ratio;
+	}
+	return string_compose ("%1.%2", peakpath, fpp);
+}
+
+void
+AudioSource::setup_peak_levels ()
+{
+	samplecnt_t fpp = _FPP;
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		fpp *= peak_level_ratio;
+		_peak_levels[l].fpp = fpp;
+		_peak_levels[l].path = peak_level_path (_peakpath, l);
+	}
+}
+
+/** Open the files of all levels for writing. _lock MUST be held by caller.
+ *  @param truncate true to discard any existing level data
+ */
+void
+AudioSource::open_peak_levels (bool truncate)
+{
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_levels[l]);
+
+		if (pl.fd < 0 && (pl.fd = g_open (pl.path.c_str(), O_CREAT|O_RDWR, 0664)) < 0) {
+			/* not fatal, reads will use the main peakfile */
+			warning << string_compose(_("AudioSource: cannot open peak level file \"%1\" (%2)"), pl.path, strerror (errno)) << endmsg;
+			continue;
+		}
+
+		pl.index = -1;
+
+		if (truncate) {
+			if (ftruncate (pl.fd, 0)) {
+				/* the stale data will be overwritten */
+			}
+			pl.byte_max = 0;
+			pl.built = false;
+		}
+	}
+}
+
+void
+AudioSource::close_peak_levels ()
+{
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_levels[l]);
+		if (pl.fd >= 0) {
+			close (pl.fd);
+			pl.fd = -1;
+		}
+		pl.index = -1;
+	}
+}
+
+void
+AudioSource::remove_peak_levels ()
+{
+	close_peak_levels ();
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		::g_unlink (_peak_levels[l].path.c_str());
+		_peak_levels[l].built = false;
+		_peak_levels[l].byte_max = 0;
+	}
+}
+
+/** Fold peaks of the level below (level 0 being the main peakfile) into
+ *  level @a level, and write the peaks that this completes.
+ *  _lock MUST be held by caller.
+ *
+ *  @param first_index Index of the first peak in @a peaks, in the level below.
+ */
+int
+AudioSource::accumulate_peak_levels (uint32_t level, PeakData const* peaks, off_t first_index, samplecnt_t npeaks)
+{
+	if (level >= n_peak_levels || npeaks == 0) {
+		return 0;
+	}
+
+	PeakLevel& pl (_peak_levels[level]);
+
+	if (pl.fd < 0) {
+		return 0;
+	}
+
+	boost::scoped_array<PeakData> completed (new PeakData[npeaks / peak_level_ratio + 2]);
+	off_t first_completed = 0;
+	samplecnt_t n_completed = 0;
+
+	for (samplecnt_t i = 0; i < npeaks; ++i) {
+
+		off_t const index = (first_index + i) / peak_level_ratio;
+
+		if (index == pl.index) {
+			pl.acc.max = max (pl.acc.max, peaks[i].max);
+			pl.acc.min = min (pl.acc.min, peaks[i].min);
+			continue;
+		}
+
+		if (pl.index >= 0) {
+			/* the peak at pl.index is done */
+			if (n_completed > 0 && pl.index != first_completed + n_completed) {
+				/* not contiguous (the writer has seeked), write what we have */
+				if (write_peak_level (level, completed.get(), first_completed, n_completed)) {
+					return -1;
+				}
+				n_completed = 0;
+			}
+			if (n_completed == 0) {
+				first_completed = pl.index;
+			}
+			completed[n_completed++] = pl.acc;
+		}
+
+		pl.index = index;
+		pl.acc = peaks[i];
+	}
+
+	if (n_completed > 0) {
+		return write_peak_level (level, completed.get(), first_completed, n_completed);
+	}
+
+	return 0;
+}
+
+int
+AudioSource::write_peak_level (uint32_t level, PeakData const* peaks, off_t first_index, samplecnt_t npeaks)
+{
+	PeakLevel& pl (_peak_levels[level]);
+	off_t const first_peak_byte = first_index * sizeof (PeakData);
+	ssize_t const bytes_to_write = npeaks * sizeof (PeakData);
+
+	if (lseek (pl.fd, first_peak_byte, SEEK_SET) != first_peak_byte) {
+		error << string_compose(_("%1: could not seek in peak level data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	if (::write (pl.fd, peaks, bytes_to_write) != bytes_to_write) {
+		error << string_compose(_("%1: could not write peak level data (%2)"), _name, strerror (errno)) << endmsg;
+		return -1;
+	}
+
+	pl.byte_max = max (pl.byte_max, (off_t) (first_peak_byte + bytes_to_write));
+
+	return accumulate_peak_levels (level + 1, peaks, first_index, npeaks);
+}
+
+/** write the partially accumulated peak of every level. _lock MUST be held by caller. */
+int
+AudioSource::flush_peak_levels ()
+{
+	int ret = 0;
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_levels[l]);
+		if (pl.fd >= 0 && pl.index >= 0) {
+			/* this also feeds the partial peak into the next level.
+			 * pl.acc is kept, if more peaks arrive it is rewritten
+			 * (merging min/max again is harmless).
+			 */
+			if (write_peak_level (l, &pl.acc, pl.index, 1)) {
+				ret = -1;
+			}
+		}
+	}
+
+	return ret;
+}
+
+int
+AudioSource::build_peak_levels ()
+{
+	if (!g_atomic_int_compare_and_exchange (&_peak_levels_pending, 1, 0)) {
+		return 0;
+	}
+
+	return build_peak_levels_from_peakfile ();
+}
+
+/** Compute all levels from an existing main peakfile, e.g. one that
+ *  was written before peak levels existed. This only needs to read
+ *  the peakfile, not the audio data.
+ */
+int
+AudioSource::build_peak_levels_from_peakfile ()
+{
+	Glib::Threads::Mutex::Lock lp (_lock);
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak levels from %1\n", _peakpath));
+
+	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+
+	if (sfd < 0) {
+		return -1;
+	}
+
+	open_peak_levels (true);
+
+	const samplecnt_t bufsize = 8192;
+	boost::scoped_array<PeakData> buf (new PeakData[bufsize]);
+	off_t index = 0;
+	off_t const npeaks_total = _peak_byte_max / sizeof (PeakData);
+	int ret = 0;
+
+	while (index < npeaks_total) {
+		samplecnt_t const to_read = min ((off_t) bufsize, npeaks_total - index);
+		ssize_t const bytes_read = ::read (sfd, buf.get(), to_read * sizeof (PeakData));
+
+		if (bytes_read != (ssize_t) (to_read * sizeof (PeakData))) {
+			ret = -1;
+			break;
+		}
+
+		if (accumulate_peak_levels (0, buf.get(), index, to_read)) {
+			ret = -1;
+			break;
+		}
+
+		index += to_read;
+	}
+
+	if (ret == 0) {
+		ret = flush_peak_levels ();
+	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		_peak_levels[l].built = (ret == 0) && _peak_levels[l].fd >= 0;
+	}
+
+	close_peak_levels ();
+
+	if (ret) {
+		remove_peak_levels ();
+	}
+
+	return ret;
 }
 
 samplecnt_t
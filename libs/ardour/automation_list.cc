@@ -57,6 +57,8 @@ static void dumpit (const AutomationList& al, string prefix = "")
 AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::ParameterDescriptor& desc)
 	: ControlList(id, desc)
 	, _before (0)
+	, _events_cache_serial (0)
+	, _events_cache_valid (false)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -71,6 +73,8 @@ AutomationList::AutomationList (const Evoral::Parameter& id, const Evoral::Param
 AutomationList::AutomationList (const Evoral::Parameter& id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id))
 	, _before (0)
+	, _events_cache_serial (0)
+	, _events_cache_valid (false)
 {
 	_state = Off;
 	g_atomic_int_set (&_touching, 0);
@@ -86,6 +90,8 @@ AutomationList::AutomationList (const AutomationList& other)
 	: ControlList(other)
 	, StatefulDestructible()
 	, _before (0)
+	, _events_cache_serial (0)
+	, _events_cache_valid (false)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -99,6 +105,8 @@ AutomationList::AutomationList (const AutomationList& other)
 AutomationList::AutomationList (const AutomationList& other, double start, double end)
 	: ControlList(other, start, end)
 	, _before (0)
+	, _events_cache_serial (0)
+	, _events_cache_valid (false)
 {
 	_state = other._state;
 	g_atomic_int_set (&_touching, other.touching());
@@ -115,6 +123,8 @@ AutomationList::AutomationList (const AutomationList& other, double start, doubl
 AutomationList::AutomationList (const XMLNode& node, Evoral::Parameter id)
 	: ControlList(id, ARDOUR::ParameterDescriptor(id))
 	, _before (0)
+	, _events_cache_serial (0)
+	, _events_cache_valid (false)
 {
 	g_atomic_int_set (&_touching, 0);
 	_interpolation = default_interpolation ();
@@ -381,23 +391,35 @@ XMLNode&
 AutomationList::serialize_events (bool need_lock)
 {
 	XMLNode* node = new XMLNode (X_("events"));
-	stringstream str;
 
 	Glib::Threads::RWLock::ReaderLock lm (Evoral::ControlList::_lock, Glib::Threads::NOT_LOCK);
 	if (need_lock) {
 		lm.acquire ();
 	}
-	for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
-		str << PBD::to_string ((*xx)->when);
-		str << ' ';
-		str << PBD::to_string ((*xx)->value);
-		str << '\n';
+
+	/* saving a session serializes every list; only redo the
+	 * (float formatting) work for lists that changed since.
+	 */
+	Glib::Threads::Mutex::Lock cl (_events_cache_lock);
+	gint const serial = ControlList::serial ();
+
+	if (!_events_cache_valid || serial != _events_cache_serial) {
+		stringstream str;
+		for (iterator xx = _events.begin(); xx != _events.end(); ++xx) {
+			str << PBD::to_string ((*xx)->when);
+			str << ' ';
+			str << PBD::to_string ((*xx)->value);
+			str << '\n';
+		}
+		_events_cache = str.str ();
+		_events_cache_serial = serial;
+		_events_cache_valid = true;
 	}
 
 	/* XML is a bit wierd */
 
 	XMLNode* content_node = new XMLNode (X_("foo")); /* it gets renamed by libxml when we set content */
-	content_node->set_content (str.str());
+	content_node->set_content (_events_cache);
 
 	node->add_child_nocopy (*content_node);
 
@@ -17,6 +17,7 @@
 
 */
 
+#include <algorithm>
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -52,8 +53,13 @@ Butler::Butler(Session& s)
 	, midi_dstream_buffer_size(0)
 	, pool_trash(16)
 	, _xthread (true)
+	, _refill_start_sem ("butler_refill_start", 0)
+	, _refill_done_sem ("butler_refill_done", 0)
 {
 	g_atomic_int_set(&should_do_transport_work, 0);
+	g_atomic_int_set(&_refill_next, 0);
+	g_atomic_int_set(&_refill_outstanding, 0);
+	g_atomic_int_set(&_refill_quit, 0);
 	SessionEvent::pool->set_trash (&pool_trash);
 
         /* catch future changes to parameters */
@@ -136,6 +142,10 @@ Butler::start_thread()
 	//pthread_detach (thread);
 	have_thread = true;
 
+	if (start_refill_threads ()) {
+		return -1;
+	}
+
 	// we are ready to request buffer adjustments
 	_session.adjust_capture_buffering ();
 	_session.adjust_playback_buffering ();
@@ -152,6 +162,156 @@ Butler::terminate_thread ()
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
 	}
+	terminate_refill_threads ();
+}
+
+int
+Butler::start_refill_threads ()
+{
+	const uint32_t n_threads = Config->get_butler_refill_threads ();
+
+	g_atomic_int_set (&_refill_quit, 0);
+
+	for (uint32_t i = 0; i < n_threads; ++i) {
+		pthread_t t;
+		if (pthread_create_and_store (string_compose ("disk refill %1", i), &t, _refill_thread_work, this)) {
+			error << _("Session: could not create butler refill thread") << endmsg;
+			terminate_refill_threads ();
+			return -1;
+		}
+		_refill_threads.push_back (t);
+	}
+
+	return 0;
+}
+
+void
+Butler::terminate_refill_threads ()
+{
+	g_atomic_int_set (&_refill_quit, 1);
+
+	for (std::vector<pthread_t>::const_iterator i = _refill_threads.begin (); i != _refill_threads.end (); ++i) {
+		_refill_start_sem.signal ();
+	}
+	for (std::vector<pthread_t>::const_iterator i = _refill_threads.begin (); i != _refill_threads.end (); ++i) {
+		void* status;
+		pthread_join (*i, &status);
+	}
+	_refill_threads.clear ();
+}
+
+void *
+Butler::_refill_thread_work (void* arg)
+{
+	/* refills may queue session events, just like the butler itself */
+	SessionEvent::create_per_thread_pool ("butler refill events", 512);
+	pthread_set_name (X_("butler refill"));
+	return ((Butler *) arg)->refill_thread_work ();
+}
+
+void *
+Butler::refill_thread_work ()
+{
+	/* see DiskReader::_do_refill_with_alloc() for the size */
+	Sample* mixdown_buffer = new Sample[2*1048576];
+	gain_t* gain_buffer    = new gain_t[2*1048576];
+
+	while (true) {
+		_refill_start_sem.wait ();
+		if (g_atomic_int_get (&_refill_quit)) {
+			break;
+		}
+		refill_some (mixdown_buffer, gain_buffer);
+		_refill_done_sem.signal ();
+	}
+
+	delete [] mixdown_buffer;
+	delete [] gain_buffer;
+	return 0;
+}
+
+/** Called by the butler and its worker threads: refill tracks from
+ *  _refill_queue until none are left, or the butler has other work to do.
+ *  A null @param mixdown_buffer uses DiskReader's (butler thread only)
+ *  working buffers.
+ */
+void
+Butler::refill_some (Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	while (!transport_work_requested() && should_run) {
+
+		const guint n = g_atomic_int_add (&_refill_next, 1);
+
+		if (n >= _refill_queue.size ()) {
+			break;
+		}
+
+		boost::shared_ptr<Track> tr = _refill_queue[n];
+
+		switch (mixdown_buffer ? tr->do_refill (mixdown_buffer, gain_buffer) : tr->do_refill ()) {
+		case 0:
+			break;
+
+		case 1:
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+			g_atomic_int_set (&_refill_outstanding, 1);
+			break;
+
+		default:
+			error << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << endmsg;
+			std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), tr->name()) << std::endl;
+			break;
+		}
+	}
+}
+
+void
+Butler::prefetch_tracks (RouteList const& rl)
+{
+	for (RouteList::const_iterator i = rl.begin(); i != rl.end(); ++i) {
+		boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (!tr) {
+			continue;
+		}
+		boost::shared_ptr<IO> io = tr->input ();
+		if (io && !io->active()) {
+			continue;
+		}
+		tr->add_read_requests (_read_batch);
+	}
+
+	_read_batch.submit ();
+}
+
+/** Refill @param tracks using the butler thread and all refill threads.
+ *  @return true if there is disk work outstanding
+ */
+bool
+Butler::refill_tracks (std::vector<boost::shared_ptr<Track> > const& tracks)
+{
+	_refill_queue = tracks;
+
+	g_atomic_int_set (&_refill_outstanding, 0);
+	g_atomic_int_set (&_refill_next, 0);
+
+	const uint32_t n_helpers = std::min (_refill_threads.size (), tracks.size () > 0 ? tracks.size () - 1 : 0);
+
+	for (uint32_t i = 0; i < n_helpers; ++i) {
+		_refill_start_sem.signal ();
+	}
+
+	refill_some (0, 0);
+
+	for (uint32_t i = 0; i < n_helpers; ++i) {
+		_refill_done_sem.wait ();
+	}
+
+	/* did we get to all the streams? */
+	bool outstanding = g_atomic_int_get (&_refill_outstanding) || (guint) g_atomic_int_get (&_refill_next) < _refill_queue.size ();
+
+	_refill_queue.clear ();
+
+	return outstanding;
 }
 
 void *
@@ -231,38 +391,68 @@ Butler::thread_work ()
 
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested()));
 
-		for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
-
-			boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+		if (should_run && !transport_work_requested() && Config->get_batch_disk_reads()) {
+			prefetch_tracks (rl_with_auditioner);
+		}
 
-			if (!tr) {
-				continue;
-			}
+		if (!_refill_threads.empty ()) {
 
-			boost::shared_ptr<IO> io = tr->input ();
+			std::vector<boost::shared_ptr<Track> > tracks;
 
-			if (io && !io->active()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
+			for (i = rl_with_auditioner.begin(); i != rl_with_auditioner.end(); ++i) {
+				boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+				if (!tr) {
+					continue;
+				}
+				boost::shared_ptr<IO> io = tr->input ();
+				if (io && !io->active()) {
+					/* don't read inactive tracks */
+					continue;
+				}
+				tracks.push_back (tr);
 			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-			case 0:
-				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-				break;
-
-			case 1:
-				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
-				disk_work_outstanding = true;
-				break;
-
-			default:
-				error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
-                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
-				break;
+
+			if (should_run && !transport_work_requested()) {
+				disk_work_outstanding = refill_tracks (tracks);
 			}
 
+			i = rl_with_auditioner.end();
+
+		} else {
+
+			for (i = rl_with_auditioner.begin(); !transport_work_requested() && should_run && i != rl_with_auditioner.end(); ++i) {
+
+				boost::shared_ptr<Track> tr = boost::dynamic_pointer_cast<Track> (*i);
+
+				if (!tr) {
+					continue;
+				}
+
+				boost::shared_ptr<IO> io = tr->input ();
+
+				if (io && !io->active()) {
+					/* don't read inactive tracks */
+					// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+					continue;
+				}
+				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+				switch (tr->do_refill ()) {
+				case 0:
+					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+					break;
+
+				case 1:
+					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name()));
+					disk_work_outstanding = true;
+					break;
+
+				default:
+					error << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << endmsg;
+	                                std::cerr << string_compose(_("Butler read ahead failure on dstream %1"), (*i)->name()) << std::endl;
+					break;
+				}
+
+			}
 		}
 
 		if (i != rl_with_auditioner.begin() && i != rl_with_auditioner.end()) {
@@ -23,7 +23,9 @@
 #include "pbd/memento_command.h"
 
 #include "ardour/audioengine.h"
+#include "ardour/audiofilesource.h"
 #include "ardour/audioplaylist.h"
+#include "ardour/audioregion.h"
 #include "ardour/audio_buffer.h"
 #include "ardour/butler.h"
 #include "ardour/debug.h"
@@ -34,6 +36,7 @@
 #include "ardour/pannable.h"
 #include "ardour/playlist.h"
 #include "ardour/playlist_factory.h"
+#include "ardour/read_batch.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
 
@@ -235,7 +238,7 @@ DiskReader::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
                  double speed, pframes_t nframes, bool result_required)
 {
 	uint32_t n;
-	boost::shared_ptr<ChannelList> c = channels.reader();
+	ChannelList* c = channels.rt_reader ();
 	ChannelList::iterator chan;
 	sampleoffset_t disk_samples_to_consume;
 	MonitorState ms = _route->monitoring_state ();
@@ -718,15 +721,16 @@ void swap_by_ptr (Sample *first, Sample *last)
 	}
 }
 
-/** Read some data for 1 channel from our playlist into a buffer.
- *  @param buf Buffer to write to.
+/** Read some data for one or more channels from our playlist into buffers.
+ *  @param bufs Buffers to write to, bufs[n] receives channel + n.
+ *  @param n_chans Number of buffers in @param bufs
  *  @param start Session sample to start reading from; updated to where we end up
  *         after the read.
  *  @param cnt Count of samples to read.
  *  @param reversed true if we are running backwards, otherwise false.
  */
 int
-DiskReader::audio_read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
+DiskReader::audio_read (Sample** bufs, uint32_t n_chans, Sample* mixdown_buffer, float* gain_buffer,
                         samplepos_t& start, samplecnt_t cnt,
                         int channel, bool reversed)
 {
@@ -738,10 +742,14 @@ DiskReader::audio_read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 	Location *loc = 0;
 
 	if (!_playlists[DataType::AUDIO]) {
-		memset (buf, 0, sizeof (Sample) * cnt);
+		for (uint32_t n = 0; n < n_chans; ++n) {
+			memset (bufs[n], 0, sizeof (Sample) * cnt);
+		}
 		return 0;
 	}
 
+	std::vector<Sample*> dst (n_chans);
+
 	/* XXX we don't currently play loops in reverse. not sure why */
 
 	if (!reversed) {
@@ -798,7 +806,11 @@ DiskReader::audio_read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 
 		this_read = min(cnt,this_read);
 
-		if (audio_playlist()->read (buf+offset, mixdown_buffer, gain_buffer, start, this_read, channel) != this_read) {
+		for (uint32_t n = 0; n < n_chans; ++n) {
+			dst[n] = bufs[n] + offset;
+		}
+
+		if (audio_playlist()->read_channels (&dst[0], n_chans, mixdown_buffer, gain_buffer, start, this_read, channel) != this_read) {
 			error << string_compose(_("DiskReader %1: cannot read %2 from playlist at sample %3"), id(), this_read,
 					 start) << endmsg;
 			return -1;
@@ -806,7 +818,9 @@ DiskReader::audio_read (Sample* buf, Sample* mixdown_buffer, float* gain_buffer,
 
 		if (reversed) {
 
-			swap_by_ptr (buf, buf + this_read - 1);
+			for (uint32_t n = 0; n < n_chans; ++n) {
+				swap_by_ptr (dst[n], dst[n] + this_read - 1);
+			}
 
 		} else {
 
@@ -871,6 +885,103 @@ DiskReader::refill (Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill
  *
  */
 
+/** @return the number of samples to read at once when @a total_space
+ *  samples of the buffers can be refilled
+ */
+samplecnt_t
+DiskReader::refill_read_size (samplecnt_t total_space) const
+{
+	/* total_space is in samples. We want to optimize read sizes in various sizes using bytes */
+
+	const size_t bits_per_sample = format_data_width (_session.config.get_native_file_data_format());
+	size_t total_bytes = total_space * bits_per_sample / 8;
+
+	/* chunk size range is 256kB to 4MB. Bigger is faster in terms of MB/sec, but bigger chunk size always takes longer
+	 */
+	size_t byte_size_for_read = max ((size_t) (256 * 1024), min ((size_t) (4 * 1048576), total_bytes));
+
+	/* find nearest (lower) multiple of 16384 */
+
+	byte_size_for_read = (byte_size_for_read / 16384) * 16384;
+
+	/* now back to samples */
+
+	return byte_size_for_read / (bits_per_sample / 8);
+}
+
+/** Add the source ranges that the next refill_audio() will read to @a batch,
+ *  using the same conditions. This is only a hint: loops, layering and
+ *  fades are not taken into account.
+ */
+void
+DiskReader::add_read_requests (ReadBatch& batch) const
+{
+	if (_session.loading()) {
+		return;
+	}
+
+	boost::shared_ptr<AudioPlaylist> pl = audio_playlist ();
+	boost::shared_ptr<ChannelList> c = channels.reader();
+
+	if (!pl || c->empty()) {
+		return;
+	}
+
+	RingBufferNPT<Sample>::rw_vector vector;
+	c->front()->buf->get_write_vector (&vector);
+
+	samplecnt_t const total_space = vector.len[0] + vector.len[1];
+
+	if (total_space == 0 || ((total_space < _chunk_samples) && fabs (_session.transport_speed()) < 2.0f)) {
+		return;
+	}
+
+	/* see refill_audio_channels() */
+	samplecnt_t const samples_to_read = refill_read_size (total_space);
+	samplecnt_t const cnt = ((samplecnt_t) vector.len[0] > samples_to_read) ? samples_to_read : total_space;
+
+	samplepos_t const ffa = file_sample[DataType::AUDIO];
+	samplepos_t start;
+	samplepos_t end;
+
+	if (_session.transport_speed() < 0.0f) {
+		start = max ((samplepos_t) 0, ffa - cnt);
+		end = ffa;
+	} else {
+		if (ffa > max_samplepos - cnt) {
+			return;
+		}
+		start = ffa;
+		end = ffa + cnt;
+	}
+
+	if (start >= end) {
+		return;
+	}
+
+	boost::shared_ptr<RegionList> rl = pl->regions_touched (start, end - 1);
+
+	for (RegionList::const_iterator r = rl->begin(); r != rl->end(); ++r) {
+
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (*r);
+
+		if (!ar || ar->muted()) {
+			continue;
+		}
+
+		samplepos_t const rs = max (start, ar->position());
+		samplepos_t const re = min (end, ar->position() + ar->length());
+
+		if (rs >= re) {
+			continue;
+		}
+
+		for (uint32_t n = 0; n < ar->n_channels() && n < c->size(); ++n) {
+			batch.add (boost::dynamic_pointer_cast<AudioFileSource> (ar->audio_source (n)), ar->start() + (rs - ar->position()), re - rs);
+		}
+	}
+}
+
 int
 DiskReader::refill_audio (Sample* mixdown_buffer, float* gain_buffer, samplecnt_t fill_level)
 {
@@ -1015,105 +1126,114 @@ DiskReader::refill_audio (Sample* mixdown_buffer, float* gain_buffer, samplecnt_
 	}
 
 	samplepos_t file_sample_tmp = 0;
+	samplecnt_t samples_to_read = refill_read_size (total_space);
 
-	/* total_space is in samples. We want to optimize read sizes in various sizes using bytes */
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: will refill %2 channels with %3 samples\n", name(), c->size(), total_space));
 
-	const size_t bits_per_sample = format_data_width (_session.config.get_native_file_data_format());
-	size_t total_bytes = total_space * bits_per_sample / 8;
+	// uint64_t before = g_get_monotonic_time ();
+	// uint64_t elapsed;
 
-	/* chunk size range is 256kB to 4MB. Bigger is faster in terms of MB/sec, but bigger chunk size always takes longer
-	 */
-	size_t byte_size_for_read = max ((size_t) (256 * 1024), min ((size_t) (4 * 1048576), total_bytes));
+	/* In the common case all channel buffers share size and write position,
+	   and all channels can be read in a single pass over the playlist.
+	*/
 
-	/* find nearest (lower) multiple of 16384 */
+	bool same_layout = true;
 
-	byte_size_for_read = (byte_size_for_read / 16384) * 16384;
+	for (i = c->begin(); i != c->end(); ++i) {
+		if ((*i)->buf->bufsize() != c->front()->buf->bufsize() || (*i)->buf->get_write_ptr() != c->front()->buf->get_write_ptr()) {
+			same_layout = false;
+			break;
+		}
+	}
 
-	/* now back to samples */
+	if (same_layout) {
 
-	samplecnt_t samples_to_read = byte_size_for_read / (bits_per_sample / 8);
+		file_sample_tmp = ffa;
 
-	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: will refill %2 channels with %3 samples\n", name(), c->size(), total_space));
+		if (refill_audio_channels (*c, mixdown_buffer, gain_buffer, file_sample_tmp, total_space, samples_to_read, reversed)) {
+			ret = -1;
+			goto out;
+		}
 
-	// uint64_t before = g_get_monotonic_time ();
-	// uint64_t elapsed;
+	} else {
 
-	for (chan_n = 0, i = c->begin(); i != c->end(); ++i, ++chan_n) {
+		for (chan_n = 0, i = c->begin(); i != c->end(); ++i, ++chan_n) {
 
-		ChannelInfo* chan (*i);
-		Sample* buf1;
-		Sample* buf2;
-		samplecnt_t len1, len2;
+			ChannelInfo* chan (*i);
+			Sample* buf1;
+			Sample* buf2;
+			samplecnt_t len1, len2;
 
-		chan->buf->get_write_vector (&vector);
+			chan->buf->get_write_vector (&vector);
 
-		if ((samplecnt_t) vector.len[0] > samples_to_read) {
+			if ((samplecnt_t) vector.len[0] > samples_to_read) {
 
-			/* we're not going to fill the first chunk, so certainly do not bother with the
-			   other part. it won't be connected with the part we do fill, as in:
+				/* we're not going to fill the first chunk, so certainly do not bother with the
+				   other part. it won't be connected with the part we do fill, as in:
 
-			   .... => writable space
-			   ++++ => readable space
-			   ^^^^ => 1 x disk_read_chunk_samples that would be filled
+				   .... => writable space
+				   ++++ => readable space
+				   ^^^^ => 1 x disk_read_chunk_samples that would be filled
 
-			   |......|+++++++++++++|...............................|
-			   buf1                buf0
-			                        ^^^^^^^^^^^^^^^
+				   |......|+++++++++++++|...............................|
+				   buf1                buf0
+				                        ^^^^^^^^^^^^^^^
 
 
-			   So, just pretend that the buf1 part isn't there.
+				   So, just pretend that the buf1 part isn't there.
 
-			*/
+				*/
 
-			vector.buf[1] = 0;
-			vector.len[1] = 0;
+				vector.buf[1] = 0;
+				vector.len[1] = 0;
 
-		}
+			}
 
-		ts = total_space;
-		file_sample_tmp = ffa;
+			ts = total_space;
+			file_sample_tmp = ffa;
 
-		buf1 = vector.buf[0];
-		len1 = vector.len[0];
-		buf2 = vector.buf[1];
-		len2 = vector.len[1];
+			buf1 = vector.buf[0];
+			len1 = vector.len[0];
+			buf2 = vector.buf[1];
+			len2 = vector.len[1];
 
-		to_read = min (ts, len1);
-		to_read = min (to_read, (samplecnt_t) samples_to_read);
+			to_read = min (ts, len1);
+			to_read = min (to_read, (samplecnt_t) samples_to_read);
 
-		assert (to_read >= 0);
+			assert (to_read >= 0);
 
-		if (to_read) {
+			if (to_read) {
 
-			if (audio_read (buf1, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, chan_n, reversed)) {
-				ret = -1;
-				goto out;
+				if (audio_read (&buf1, 1, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, chan_n, reversed)) {
+					ret = -1;
+					goto out;
+				}
+				chan->buf->increment_write_ptr (to_read);
+				ts -= to_read;
 			}
-			chan->buf->increment_write_ptr (to_read);
-			ts -= to_read;
-		}
 
-		to_read = min (ts, len2);
+			to_read = min (ts, len2);
 
-		if (to_read) {
+			if (to_read) {
 
-			/* we read all of vector.len[0], but it wasn't the
-			   entire samples_to_read of data, so read some or
-			   all of vector.len[1] as well.
-			*/
+				/* we read all of vector.len[0], but it wasn't the
+				   entire samples_to_read of data, so read some or
+				   all of vector.len[1] as well.
+				*/
+
+				if (audio_read (&buf2, 1, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, chan_n, reversed)) {
+					ret = -1;
+					goto out;
+				}
 
-			if (audio_read (buf2, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, chan_n, reversed)) {
-				ret = -1;
-				goto out;
+				chan->buf->increment_write_ptr (to_read);
 			}
 
-			chan->buf->increment_write_ptr (to_read);
-		}
+			if (zero_fill) {
+				/* XXX: do something */
+			}
 
-		if (zero_fill) {
-			/* XXX: do something */
 		}
-
 	}
 
 	// elapsed = g_get_monotonic_time () - before;
@@ -1130,6 +1250,67 @@ DiskReader::refill_audio (Sample* mixdown_buffer, float* gain_buffer, samplecnt_
 	return ret;
 }
 
+/** Refill all channels with one read of the playlist.
+ *  Only valid if all channel buffers have the same size and write position.
+ *  @return 0 on success, -1 on error.
+ */
+int
+DiskReader::refill_audio_channels (ChannelList const& c, Sample* mixdown_buffer, float* gain_buffer,
+                                   samplepos_t& file_sample_tmp, samplecnt_t total_space, samplecnt_t samples_to_read, bool reversed)
+{
+	const uint32_t n_chans = c.size ();
+	std::vector<Sample*> buf1 (n_chans);
+	std::vector<Sample*> buf2 (n_chans);
+	RingBufferNPT<Sample>::rw_vector vector;
+	samplecnt_t len1 = max_samplecnt;
+	samplecnt_t len2 = max_samplecnt;
+	samplecnt_t to_read;
+	samplecnt_t ts = total_space;
+	uint32_t n = 0;
+
+	/* the process thread may consume data meanwhile, use the smallest
+	 * write-space of all channels.
+	 */
+	for (ChannelList::const_iterator i = c.begin(); i != c.end(); ++i, ++n) {
+		(*i)->buf->get_write_vector (&vector);
+		buf1[n] = vector.buf[0];
+		buf2[n] = vector.buf[1];
+		len1 = min (len1, (samplecnt_t) vector.len[0]);
+		len2 = min (len2, (samplecnt_t) vector.len[1]);
+	}
+
+	if (len1 > samples_to_read) {
+		/* see refill_audio() */
+		len2 = 0;
+	}
+
+	to_read = min (ts, len1);
+	to_read = min (to_read, samples_to_read);
+
+	if (to_read) {
+		if (audio_read (&buf1[0], n_chans, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, 0, reversed)) {
+			return -1;
+		}
+		for (ChannelList::const_iterator i = c.begin(); i != c.end(); ++i) {
+			(*i)->buf->increment_write_ptr (to_read);
+		}
+		ts -= to_read;
+	}
+
+	to_read = min (ts, len2);
+
+	if (to_read) {
+		if (audio_read (&buf2[0], n_chans, mixdown_buffer, gain_buffer, file_sample_tmp, to_read, 0, reversed)) {
+			return -1;
+		}
+		for (ChannelList::const_iterator i = c.begin(); i != c.end(); ++i) {
+			(*i)->buf->increment_write_ptr (to_read);
+		}
+	}
+
+	return 0;
+}
+
 void
 DiskReader::playlist_ranges_moved (list< Evoral::RangeMove<samplepos_t> > const & movements_samples, bool from_undo)
 {
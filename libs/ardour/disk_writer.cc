@@ -349,7 +349,7 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 	_active = _pending_active;
 
 	uint32_t n;
-	boost::shared_ptr<ChannelList> c = channels.reader();
+	ChannelList* c = channels.rt_reader ();
 	ChannelList::iterator chan;
 
 	samplecnt_t rec_offset = 0;
@@ -573,7 +573,7 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 		/* not recording this time, but perhaps we were before .. */
 
 		if (was_recording) {
-			finish_capture (c);
+			finish_capture (*c);
 			_accumulated_capture_offset = 0;
 		}
 	}
@@ -596,7 +596,7 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 }
 
 void
-DiskWriter::finish_capture (boost::shared_ptr<ChannelList> c)
+DiskWriter::finish_capture (ChannelList const& c)
 {
 	was_recording = false;
 	first_recordable_sample = max_samplepos;
@@ -607,7 +607,7 @@ DiskWriter::finish_capture (boost::shared_ptr<ChannelList> c)
 	}
 
 	if (recordable() && destructive()) {
-		for (ChannelList::iterator chan = c->begin(); chan != c->end(); ++chan) {
+		for (ChannelList::const_iterator chan = c.begin(); chan != c.end(); ++chan) {
 
 			RingBufferNPT<CaptureTransition>::rw_vector transvec;
 			(*chan)->capture_transition_buf->get_write_vector(&transvec);
@@ -1113,7 +1113,7 @@ DiskWriter::transport_stopped_wallclock (struct tm& when, time_t twhen, bool abo
 	uint32_t n = 0;
 	bool mark_write_completed = false;
 
-	finish_capture (c);
+	finish_capture (*c);
 
 
 	/* butler is already stopped, but there may be work to do
@@ -1269,7 +1269,7 @@ DiskWriter::transport_looped (samplepos_t transport_sample)
 		// all we need to do is finish this capture, with modified capture length
 		boost::shared_ptr<ChannelList> c = channels.reader();
 
-		finish_capture (c);
+		finish_capture (*c);
 
 		// the next region will start recording via the normal mechanism
 		// we'll set the start position to the current transport pos
@@ -58,7 +58,6 @@ namespace ARDOUR {
 
 ExportGraphBuilder::ExportGraphBuilder (Session const & session)
 	: session (session)
-	, thread_pool (hardware_concurrency())
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
 }
@@ -67,6 +66,18 @@ ExportGraphBuilder::~ExportGraphBuilder ()
 {
 }
 
+Glib::ThreadPool&
+ExportGraphBuilder::thread_pool ()
+{
+	/* Timespans exported in the same pass each have a graph, which
+	 * must not add up to more threads than there are cores. A Threader
+	 * processes one of its outputs in the calling thread.
+	 * Never freed, threads may still be running at exit.
+	 */
+	static Glib::ThreadPool* pool = new Glib::ThreadPool (std::max (1, (int) hardware_concurrency () - 1));
+	return *pool;
+}
+
 int
 ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 {
@@ -83,6 +94,33 @@ ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 	return 0;
 }
 
+void
+ExportGraphBuilder::read_channels (ChannelData& data, samplecnt_t samples)
+{
+	assert(samples <= process_buffer_samples);
+
+	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+		Sample const *& process_buffer = data[it->first.get()];
+		if (!process_buffer) {
+			it->first->read (process_buffer, samples);
+		}
+	}
+}
+
+int
+ExportGraphBuilder::process (ChannelData const& data, samplecnt_t offset, samplecnt_t samples, bool last_cycle)
+{
+	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+		ChannelData::const_iterator d = data.find (it->first.get());
+		assert (d != data.end() && d->second);
+		ConstProcessContext<Sample> context(d->second + offset, samples, 1);
+		if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+		it->second->process (context);
+	}
+
+	return 0;
+}
+
 bool
 ExportGraphBuilder::post_process ()
 {
@@ -440,7 +478,7 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 	}
 
 	normalizer.reset (new AudioGrapher::Normalizer (use_loudness ? 0.0 : config.format->normalize_dbfs()));
-	threader.reset (new Threader<Sample> (parent.thread_pool));
+	threader.reset (new Threader<Sample> (ExportGraphBuilder::thread_pool ()));
 	normalizer->alloc_buffer (max_samples_out);
 	normalizer->add_output (threader);
 
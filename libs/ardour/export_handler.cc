@@ -18,6 +18,8 @@
 
 */
 
+#include <algorithm>
+
 #include "ardour/export_handler.h"
 
 #include "pbd/gstdio_compat.h"
@@ -36,6 +38,8 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/rt_tasklist.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/system_exec.h"
 #include "pbd/openuri.h"
@@ -121,6 +125,10 @@ ExportHandler::ExportHandler (Session & session)
 ExportHandler::~ExportHandler ()
 {
 	graph_builder->cleanup (export_status->aborted () );
+
+	for (std::vector<boost::shared_ptr<ExportGraphBuilder> >::iterator i = pass_graph_builders.begin(); i != pass_graph_builders.end(); ++i) {
+		(*i)->cleanup (export_status->aborted ());
+	}
 }
 
 /** Add an export to the `to-do' list */
@@ -175,42 +183,93 @@ ExportHandler::start_timespan ()
 		return;
 	}
 
-	/* finish_timespan pops the config_map entry that has been done, so
-	   this is the timespan to do this time
+	/* finish_timespan pops the config_map entries that have been done, so
+	   this is the (first) timespan to do this time
 	*/
 	current_timespan = config_map.begin()->first;
 
-	export_status->total_samples_current_timespan = current_timespan->get_length();
-	export_status->timespan_name = current_timespan->name();
-	export_status->processed_samples_current_timespan = 0;
-
-	/* Register file configurations to graph builder */
-
 	/* Here's the config_map entries that use this timespan */
 	timespan_bounds = config_map.equal_range (current_timespan);
-	graph_builder->reset ();
-	graph_builder->set_current_timespan (current_timespan);
-	handle_duplicate_format_extensions();
+
 	bool realtime = current_timespan->realtime ();
-	bool region_export = true;
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
-		// Filenames can be shared across timespans
-		FileSpec & spec = it->second;
-		spec.filename->set_timespan (it->first);
-		switch (spec.channel_config->region_processing_type ()) {
-			case RegionExportChannelFactory::None:
-			case RegionExportChannelFactory::Processed:
-				region_export = false;
-				break;
-			default:
-				break;
-		}
-		graph_builder->add_config (spec, realtime);
-	}
+	bool region_export = is_region_export (timespan_bounds);
 
 	// ExportDialog::update_realtime_selection does not allow this
 	assert (!region_export || !realtime);
 
+	/* Register file configurations to graph builder */
+
+	pass_timespans.clear ();
+	add_pass_timespan (current_timespan, graph_builder, realtime);
+	pass_end = current_timespan->get_end ();
+
+	if (Config->get_export_timespans_in_one_pass () && !realtime && !region_export) {
+		/* Timespans that overlap this one, or begin within the export
+		 * pre-roll after its end, are rendered in the same session pass
+		 * rather than locating and pre-rolling again for each of them.
+		 * config_map is ordered by pointer, not by time, so consider all
+		 * of its timespans.
+		 */
+		samplecnt_t const max_gap = Config->get_export_preroll () * session.nominal_sample_rate ();
+
+		std::vector<ExportTimespanPtr> candidates;
+		for (ConfigMap::iterator next = timespan_bounds.second; next != config_map.end (); ) {
+			ExportTimespanPtr ts = next->first;
+			TimespanBounds bounds = config_map.equal_range (ts);
+			if (!ts->realtime () && !is_region_export (bounds)) {
+				candidates.push_back (ts);
+			}
+			next = bounds.second;
+		}
+
+		std::vector<ExportTimespanPtr> group = pass_group (current_timespan, candidates, max_gap);
+
+		for (std::vector<ExportTimespanPtr>::const_iterator i = group.begin(); i != group.end(); ++i) {
+			TimespanBounds bounds = config_map.equal_range (*i);
+
+			/* Filenames can be shared across timespans, but all of them
+			 * are in use at the same time here.
+			 */
+			for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
+				it->second.filename.reset (new ExportFilename (*it->second.filename));
+			}
+
+			size_t n = pass_timespans.size ();
+			if (pass_graph_builders.size () < n) {
+				pass_graph_builders.push_back (boost::shared_ptr<ExportGraphBuilder> (new ExportGraphBuilder (session)));
+			}
+			add_pass_timespan (*i, pass_graph_builders[n - 1], false);
+
+			pass_end = std::max (pass_end, (*i)->get_end ());
+		}
+	}
+
+	samplecnt_t length = 0;
+	std::string name;
+
+	pass_tasks.clear ();
+	pass_post_tasks.clear ();
+	pass_channel_data.clear ();
+
+	for (std::vector<PassTimespan>::iterator t = pass_timespans.begin(); t != pass_timespans.end(); ++t) {
+		length += t->timespan->get_length();
+		if (!name.empty ()) {
+			name += ", ";
+		}
+		name += t->timespan->name();
+
+		if (pass_timespans.size () > 1) {
+			/* pass_timespans is not modified until the next pass */
+			pass_tasks.push_back (boost::bind (&ExportHandler::process_pass_timespan, this, &(*t)));
+			pass_post_tasks.push_back (boost::bind (&ExportHandler::post_process_pass_timespan, this, &(*t)));
+		}
+	}
+
+	export_status->timespan += pass_timespans.size () - 1;
+	export_status->total_samples_current_timespan = length;
+	export_status->timespan_name = name;
+	export_status->processed_samples_current_timespan = 0;
+
 	/* start export */
 
 	post_processing = false;
@@ -220,13 +279,78 @@ ExportHandler::start_timespan ()
 	session.start_audio_export (process_position, realtime, region_export);
 }
 
+struct TimespanSortByStart {
+	bool operator() (ExportTimespanPtr const & a, ExportTimespanPtr const & b) const {
+		return a->get_start () < b->get_start ();
+	}
+};
+
+std::vector<ExportTimespanPtr>
+ExportHandler::pass_group (ExportTimespanPtr first, std::vector<ExportTimespanPtr> candidates, samplecnt_t max_gap)
+{
+	std::vector<ExportTimespanPtr> group;
+	samplepos_t end = first->get_end ();
+
+	/* the pass starts with @a first, so nothing that starts
+	 * (and maybe ends) before it can be part of it.
+	 */
+	std::stable_sort (candidates.begin (), candidates.end (), TimespanSortByStart ());
+
+	for (std::vector<ExportTimespanPtr>::const_iterator i = candidates.begin(); i != candidates.end(); ++i) {
+		if (*i == first || (*i)->get_start () < first->get_start ()) {
+			continue;
+		}
+		if ((*i)->get_start () > end + max_gap) {
+			/* sorted, none of the rest can join either */
+			break;
+		}
+		group.push_back (*i);
+		end = std::max (end, (*i)->get_end ());
+	}
+
+	return group;
+}
+
+bool
+ExportHandler::is_region_export (TimespanBounds const & bounds) const
+{
+	for (ConfigMap::const_iterator it = bounds.first; it != bounds.second; ++it) {
+		switch (it->second.channel_config->region_processing_type ()) {
+			case RegionExportChannelFactory::None:
+			case RegionExportChannelFactory::Processed:
+				return false;
+			default:
+				break;
+		}
+	}
+	return true;
+}
+
+void
+ExportHandler::add_pass_timespan (ExportTimespanPtr timespan, boost::shared_ptr<ExportGraphBuilder> builder, bool realtime)
+{
+	TimespanBounds bounds = config_map.equal_range (timespan);
+
+	builder->reset ();
+	builder->set_current_timespan (timespan);
+	handle_duplicate_format_extensions (bounds);
+	for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
+		// Filenames can be shared across timespans
+		FileSpec & spec = it->second;
+		spec.filename->set_timespan (it->first);
+		builder->add_config (spec, realtime);
+	}
+
+	pass_timespans.push_back (PassTimespan (timespan, builder));
+}
+
 void
-ExportHandler::handle_duplicate_format_extensions()
+ExportHandler::handle_duplicate_format_extensions (TimespanBounds const & bounds)
 {
 	typedef std::map<std::string, int> ExtCountMap;
 
 	ExtCountMap counts;
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+	for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
 		counts[it->second.format->extension()]++;
 	}
 
@@ -236,7 +360,7 @@ ExportHandler::handle_duplicate_format_extensions()
 	}
 
 	// Set this always, as the filenames are shared...
-	for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+	for (ConfigMap::iterator it = bounds.first; it != bounds.second; ++it) {
 		it->second.filename->include_format_name = duplicates_found;
 	}
 }
@@ -267,7 +391,7 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	/* update position */
 
 	samplecnt_t samples_to_read = 0;
-	samplepos_t const end = current_timespan->get_end();
+	samplepos_t const end = pass_end;
 
 	bool const last_cycle = (process_position + samples >= end);
 
@@ -278,18 +402,31 @@ ExportHandler::process_timespan (samplecnt_t samples)
 		samples_to_read = samples;
 	}
 
-	process_position += samples_to_read;
-	export_status->processed_samples += samples_to_read;
-	export_status->processed_samples_current_timespan += samples_to_read;
+	int ret;
 
 	/* Do actual processing */
-	int ret = graph_builder->process (samples_to_read, last_cycle);
+	if (pass_timespans.size () == 1) {
+		export_status->processed_samples += samples_to_read;
+		export_status->processed_samples_current_timespan += samples_to_read;
+		ret = graph_builder->process (samples_to_read, last_cycle);
+	} else {
+		ret = process_pass (process_position, samples_to_read);
+	}
+
+	process_position += samples_to_read;
 
 	/* Start post-processing/normalizing if necessary */
 	if (last_cycle) {
-		post_processing = graph_builder->need_postprocessing ();
+		unsigned cycles = 0;
+		post_processing = false;
+		for (std::vector<PassTimespan>::iterator t = pass_timespans.begin(); t != pass_timespans.end(); ++t) {
+			if (t->graph_builder->need_postprocessing ()) {
+				post_processing = true;
+				cycles = std::max (cycles, t->graph_builder->get_postprocessing_cycle_count());
+			}
+		}
 		if (post_processing) {
-			export_status->total_postprocessing_cycles = graph_builder->get_postprocessing_cycle_count();
+			export_status->total_postprocessing_cycles = cycles;
 			export_status->current_postprocessing_cycle = 0;
 		} else {
 			finish_timespan ();
@@ -300,10 +437,104 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	return ret;
 }
 
+int
+ExportHandler::process_pass (samplepos_t position, samplecnt_t samples)
+{
+	/* read each channel only once for all timespans in this cycle */
+	for (ChannelData::iterator i = pass_channel_data.begin(); i != pass_channel_data.end(); ++i) {
+		i->second = 0;
+	}
+
+	for (std::vector<PassTimespan>::iterator t = pass_timespans.begin(); t != pass_timespans.end(); ++t) {
+		if (t->done) {
+			t->active = false;
+			continue;
+		}
+
+		/* timespans that start later are read from the beginning of the
+		 * pass too, so that stateful channels run continuously.
+		 */
+		t->graph_builder->read_channels (pass_channel_data, samples);
+
+		samplepos_t const start = std::max (position, t->timespan->get_start ());
+		samplepos_t const end = std::min (position + samples, t->timespan->get_end ());
+
+		t->last_cycle = (position + samples >= t->timespan->get_end ());
+		t->active = start < end || (start == end && t->last_cycle);
+
+		if (!t->active) {
+			continue;
+		}
+
+		t->offset = start - position;
+		t->samples = end - start;
+		t->done = t->last_cycle;
+
+		export_status->processed_samples += t->samples;
+		export_status->processed_samples_current_timespan += t->samples;
+	}
+
+	/* the graphs of the timespans are independent of each other */
+	boost::shared_ptr<RTTaskList> tl = session.rt_tasklist ();
+	if (tl) {
+		tl->process (pass_tasks);
+	} else {
+		for (std::vector<boost::function<void ()> >::const_iterator i = pass_tasks.begin(); i != pass_tasks.end(); ++i) {
+			(*i)();
+		}
+	}
+
+	return 0;
+}
+
+void
+ExportHandler::process_pass_timespan (PassTimespan* t)
+{
+	if (t->active) {
+		t->graph_builder->process (pass_channel_data, t->offset, t->samples, t->last_cycle);
+	}
+}
+
+void
+ExportHandler::post_process_pass_timespan (PassTimespan* t)
+{
+	if (!t->post_processed) {
+		t->post_processed = t->graph_builder->post_process ();
+	}
+}
+
 int
 ExportHandler::post_process ()
 {
-	if (graph_builder->post_process ()) {
+	bool done;
+
+	if (pass_timespans.size () == 1) {
+		done = graph_builder->post_process ();
+	} else {
+		/* normalize and encode the timespans of the pass concurrently.
+		 *
+		 * This does not overlap with rendering the next pass:
+		 * start_timespan() reuses the graph builders of this pass (and
+		 * their Intermediates' TmpFiles), and ExportStatus reports a
+		 * single active job. Overlapping needs a set of graphs per pass
+		 * in flight, and progress per pass.
+		 */
+		boost::shared_ptr<RTTaskList> tl = session.rt_tasklist ();
+		if (tl) {
+			tl->process (pass_post_tasks);
+		} else {
+			for (std::vector<boost::function<void ()> >::const_iterator i = pass_post_tasks.begin(); i != pass_post_tasks.end(); ++i) {
+				(*i)();
+			}
+		}
+
+		done = true;
+		for (std::vector<PassTimespan>::const_iterator t = pass_timespans.begin(); t != pass_timespans.end(); ++t) {
+			done = done && t->post_processed;
+		}
+	}
+
+	if (done) {
 		finish_timespan ();
 		export_status->active_job = ExportStatus::Exporting;
 	} else {
@@ -329,12 +560,27 @@ ExportHandler::command_output(std::string output, size_t size)
 void
 ExportHandler::finish_timespan ()
 {
-	graph_builder->get_analysis_results (export_status->result_map);
+	for (std::vector<PassTimespan>::iterator t = pass_timespans.begin(); t != pass_timespans.end(); ++t) {
+		finish_pass_timespan (*t);
+	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	start_timespan ();
+}
 
-		ExportFormatSpecPtr fmt = config_map.begin()->second.format;
-		std::string filename = config_map.begin()->second.filename->get_path(fmt);
+void
+ExportHandler::finish_pass_timespan (PassTimespan& t)
+{
+	/* the timespans of a pass need not be adjacent in config_map */
+	current_timespan = t.timespan;
+	timespan_bounds = config_map.equal_range (current_timespan);
+	export_status->timespan_name = current_timespan->name();
+
+	t.graph_builder->get_analysis_results (export_status->result_map);
+
+	while (timespan_bounds.first != timespan_bounds.second) {
+
+		ExportFormatSpecPtr fmt = timespan_bounds.first->second.format;
+		std::string filename = timespan_bounds.first->second.filename->get_path(fmt);
 		if (fmt->with_cue()) {
 			export_cd_marker_file (current_timespan, fmt, filename, CDMarkerCUE);
 		}
@@ -353,7 +599,7 @@ ExportHandler::finish_timespan ()
 		 * The process cannot access the file because it is being used.
 		 * ditto for post-export and upload.
 		 */
-		graph_builder->reset ();
+		t.graph_builder->reset ();
 
 		if (fmt->tag()) {
 			/* TODO: check Umlauts and encoding in filename.
@@ -459,10 +705,8 @@ ExportHandler::finish_timespan ()
 			}
 			delete soundcloud_uploader;
 		}
-		config_map.erase (config_map.begin());
+		config_map.erase (timespan_bounds.first++);
 	}
-
-	start_timespan ();
 }
 
 /*** CD Marker stuff ***/
@@ -26,6 +26,7 @@ namespace ARDOUR {
 const char* const template_suffix = X_(".template");
 const char* const statefile_suffix = X_(".ardour");
 const char* const pending_suffix = X_(".pending");
+const char* const binary_statefile_suffix = X_(".ardour-bin");
 const char* const peakfile_suffix = X_(".peak");
 const char* const backup_suffix = X_(".bak");
 const char* const temp_suffix = X_(".tmp");
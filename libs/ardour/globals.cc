@@ -140,6 +140,9 @@ apply_gain_to_buffer_t  ARDOUR::apply_gain_to_buffer = 0;
 mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain = 0;
 copy_vector_t			ARDOUR::copy_vector = 0;
+mix_buffers_with_gain_curve_t ARDOUR::mix_buffers_with_gain_curve = 0;
+copy_vector_with_gain_curve_t ARDOUR::copy_vector_with_gain_curve = 0;
+crossfade_buffers_t           ARDOUR::crossfade_buffers = 0;
 
 PBD::Signal1<void,std::string> ARDOUR::BootMessage;
 PBD::Signal3<void,std::string,std::string,bool> ARDOUR::PluginScanMessage;
@@ -189,6 +192,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			mix_buffers_with_gain_curve = x86_sse_avx_mix_buffers_with_gain_curve;
+			copy_vector_with_gain_curve = x86_sse_avx_copy_vector_with_gain_curve;
+			crossfade_buffers           = x86_sse_avx_crossfade_buffers;
 
 			generic_mix_functions = false;
 
@@ -203,6 +209,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			mix_buffers_with_gain_curve = x86_sse_mix_buffers_with_gain_curve;
+			copy_vector_with_gain_curve = x86_sse_copy_vector_with_gain_curve;
+			crossfade_buffers           = x86_sse_crossfade_buffers;
 
 			generic_mix_functions = false;
 
@@ -217,6 +226,9 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain  = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain    = veclib_mix_buffers_no_gain;
 			copy_vector            = default_copy_vector;
+			mix_buffers_with_gain_curve = default_mix_buffers_with_gain_curve;
+			copy_vector_with_gain_curve = default_copy_vector_with_gain_curve;
+			crossfade_buffers           = default_crossfade_buffers;
 
 			generic_mix_functions = false;
 
@@ -237,6 +249,9 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		mix_buffers_with_gain_curve = default_mix_buffers_with_gain_curve;
+		copy_vector_with_gain_curve = default_copy_vector_with_gain_curve;
+		crossfade_buffers           = default_crossfade_buffers;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -549,8 +564,10 @@ ARDOUR::init (bool use_windows_vst, bool try_optimization, const char* localedir
 	/* the + 4 is a bit of a handwave. i don't actually know
 	   how many more per-thread buffer sets we need above
 	   the h/w concurrency, but its definitely > 1 more.
+	   the process graph and the RTTaskList each use up to
+	   h/w concurrency threads.
 	*/
-        BufferManager::init (hardware_concurrency() + 4);
+        BufferManager::init (2 * hardware_concurrency() + 4);
 
         PannerManager::instance().discover_panners();
 
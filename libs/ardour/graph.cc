@@ -19,6 +19,7 @@
 */
 #include <stdio.h>
 #include <cmath>
+#include <algorithm>
 
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
@@ -31,6 +32,7 @@
 #include "ardour/route.h"
 #include "ardour/process_thread.h"
 #include "ardour/audioengine.h"
+#include "ardour/rc_configuration.h"
 
 #include "pbd/i18n.h"
 
@@ -51,6 +53,29 @@ int alloc_allowed ()
 }
 #endif
 
+static void do_not_delete_the_queue_pointer (void*) { }
+
+static bool
+priority_less (GraphNode const* a, GraphNode const* b)
+{
+	return a->priority () < b->priority ();
+}
+
+static bool
+priority_greater (GraphNode const* a, GraphNode const* b)
+{
+	return a->priority () > b->priority ();
+}
+
+Glib::Threads::Private<Graph::WorkQueue> Graph::_thread_work_queue (do_not_delete_the_queue_pointer);
+
+Graph::WorkQueue::WorkQueue ()
+	: deque (8192)
+	, seed_pos (0)
+	, seed_end (0)
+{
+}
+
 Graph::Graph (Session & session)
 	: SessionHandleRef (session)
 	, _threads_active (false)
@@ -66,6 +91,8 @@ Graph::Graph (Session & session)
 	_trigger_queue.reserve (8192);
 
 	_execution_tokens = 0;
+	_work_stealing = 0;
+	_trigger_overflow = 0;
 
 	_current_chain = 0;
 	_pending_chain = 0;
@@ -121,12 +148,17 @@ Graph::reset_thread_list ()
 
 	_threads_active = true;
 
+	/* one work-stealing queue per thread, the main thread uses the first */
+	for (uint32_t i = 0; i < num_threads; ++i) {
+		_work_queues.push_back (new WorkQueue ());
+	}
+
 	if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
 		throw failed_constructor ();
 	}
 
 	for (uint32_t i = 1; i < num_threads; ++i) {
-		if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::helper_thread, this))) {
+		if (AudioEngine::instance()->create_process_thread (boost::bind (&Graph::helper_thread, this, i))) {
 			throw failed_constructor ();
 		}
 	}
@@ -142,6 +174,8 @@ Graph::session_going_away()
 	_nodes_rt[1].clear();
 	_init_trigger_list[0].clear();
 	_init_trigger_list[1].clear();
+	_init_trigger_seeds[0].clear();
+	_init_trigger_seeds[1].clear();
 	_trigger_queue.clear();
 }
 
@@ -169,6 +203,13 @@ Graph::drop_threads ()
 	_callback_done_sem.signal ();
 	_execution_tokens = 0;
 
+	for (vector<WorkQueue*>::iterator i = _work_queues.begin (); i != _work_queues.end (); ++i) {
+		delete *i;
+	}
+	_work_queues.clear ();
+	_work_stealing = 0;
+	_trigger_overflow = 0;
+
 	/* reset semaphores.
 	 * This is somewhat ugly, yet if a thread is killed (e.g jackd terminates
 	 * abnormally), some semaphores are still unlocked.
@@ -199,6 +240,7 @@ Graph::clear_other_chain ()
 
 			_nodes_rt[_setup_chain].clear ();
 			_init_trigger_list[_setup_chain].clear ();
+			_init_trigger_seeds[_setup_chain].clear ();
 			break;
 		}
 		/* setup chain == pending chain - we have
@@ -235,20 +277,88 @@ Graph::prep()
 	}
 	_finished_refcount = _init_finished_refcount[chain];
 
+	update_critical_path (chain);
+
+	if (Config->get_work_stealing_graph () && !_work_queues.empty ()) {
+		std::vector<GraphNode*>& seeds (_init_trigger_seeds[chain]);
+		const gint n_seeds  = seeds.size ();
+		const gint n_queues = _work_queues.size ();
+
+		g_atomic_int_set (&_work_stealing, 1);
+
+		/* Hand each thread a contiguous slice of the initial nodes.
+		 * The seed list is grouped by the node being fed, so nodes
+		 * that feed the same bus are usually run by the same thread.
+		 * Within a slice, nodes on the critical path go first.
+		 */
+		for (gint i = 0; i < n_queues; ++i) {
+			WorkQueue* wq = _work_queues[i];
+			const gint s = i * n_seeds / n_queues;
+			const gint e = (i + 1) * n_seeds / n_queues;
+			g_atomic_int_set (&wq->seed_pos, n_seeds);
+			std::sort (seeds.begin () + s, seeds.begin () + e, priority_greater);
+			g_atomic_int_set (&wq->seed_end, e);
+			g_atomic_int_set (&wq->seed_pos, s);
+		}
+
+		/* this thread will run one of them, wake up others for the rest */
+		ws_wakeup (n_seeds - 1);
+		return;
+	}
+
+	g_atomic_int_set (&_work_stealing, 0);
+
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
 	pthread_mutex_lock (&_trigger_mutex);
 	for (i=_init_trigger_list[chain].begin(); i!=_init_trigger_list[chain].end(); i++) {
 		/* don't use ::trigger here, as we have already locked the mutex */
 		_trigger_queue.push_back (i->get ());
 	}
+	/* run_one() takes nodes from the back, put the critical path there */
+	std::sort (_trigger_queue.begin (), _trigger_queue.end (), priority_less);
 	pthread_mutex_unlock (&_trigger_mutex);
 }
 
+/** Compute each node's priority: the cost of the most expensive path
+ *  from the node to the end of the graph, using the measured run time
+ *  of every node. Nodes on the critical path are started first, so the
+ *  last thread does not sit idle waiting for a long chain at the end
+ *  of the cycle.
+ *
+ *  This relies on _nodes_rt being in topological order, which is
+ *  what Session::resort_routes passes to rechain().
+ */
+void
+Graph::update_critical_path (int chain)
+{
+	for (node_list_t::reverse_iterator i = _nodes_rt[chain].rbegin(); i != _nodes_rt[chain].rend(); ++i) {
+		float downstream = 0;
+		for (node_set_t::const_iterator a = (*i)->_activation_set[chain].begin(); a != (*i)->_activation_set[chain].end(); ++a) {
+			downstream = max (downstream, (*a)->_priority);
+		}
+		(*i)->_priority = (*i)->_cost + downstream;
+	}
+}
+
 void
 Graph::trigger (GraphNode* n)
 {
+	if (g_atomic_int_get (&_work_stealing)) {
+		/* queue the node on the calling thread's own deque. */
+		WorkQueue* wq = _thread_work_queue.get ();
+		if (wq && wq->deque.push (n)) {
+			return;
+		}
+		/* deque is full, fall back to the shared queue */
+		g_atomic_int_inc (&_trigger_overflow);
+	}
+
 	pthread_mutex_lock (&_trigger_mutex);
 	_trigger_queue.push_back (n);
+	/* keep the queue sorted, so that run_one() picks the node on the critical path */
+	for (std::vector<GraphNode*>::iterator i = _trigger_queue.end () - 1; i != _trigger_queue.begin () && priority_less (n, *(i - 1)); --i) {
+		std::swap (*i, *(i - 1));
+	}
 	pthread_mutex_unlock (&_trigger_mutex);
 }
 
@@ -295,6 +405,12 @@ again:
 	// starting with waking up the others.
 }
 
+static bool
+seed_target_less (std::pair<GraphNode*, GraphNode*> const& a, std::pair<GraphNode*, GraphNode*> const& b)
+{
+	return a.first < b.first;
+}
+
 /** Rechain our stuff using a list of routes (which can be in any order) and
  *  a directed graph of their interconnections, which is guaranteed to be
  *  acyclic.
@@ -364,6 +480,22 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
 		}
 	}
 
+	/* Order the initial nodes for the work-stealing scheduler by the
+	 * node they feed, so that siblings are adjacent when prep() splits
+	 * the list into per-thread slices.
+	 */
+	std::vector<std::pair<GraphNode*, GraphNode*> > seeds;
+	for (node_list_t::iterator ni = _init_trigger_list[chain].begin(); ni != _init_trigger_list[chain].end(); ++ni) {
+		node_set_t const& as ((*ni)->_activation_set[chain]);
+		seeds.push_back (std::make_pair (as.empty () ? 0 : as.begin()->get (), ni->get ()));
+	}
+	std::stable_sort (seeds.begin (), seeds.end (), seed_target_less);
+
+	_init_trigger_seeds[chain].clear ();
+	for (std::vector<std::pair<GraphNode*, GraphNode*> >::const_iterator i = seeds.begin (); i != seeds.end (); ++i) {
+		_init_trigger_seeds[chain].push_back (i->second);
+	}
+
 	_pending_chain = chain;
 	dump(chain);
 }
@@ -372,10 +504,14 @@ Graph::rechain (boost::shared_ptr<RouteList> routelist, GraphEdges const & edges
  *  @return true to quit, false to carry on.
  */
 bool
-Graph::run_one()
+Graph::run_one (uint32_t thread_id)
 {
 	GraphNode* to_run;
 
+	if (g_atomic_int_get (&_work_stealing)) {
+		return run_one_ws (thread_id);
+	}
+
 	pthread_mutex_lock (&_trigger_mutex);
 	if (_trigger_queue.size()) {
 		to_run = _trigger_queue.back();
@@ -392,7 +528,7 @@ Graph::run_one()
 	/* hence how many threads to wake up */
 	int wakeup = min (et, ts);
 	/* update the number of threads that will still be sleeping */
-	_execution_tokens -= wakeup;
+	g_atomic_int_add (&_execution_tokens, -wakeup);
 
 	DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 signals %2\n", pthread_name(), wakeup));
 
@@ -401,7 +537,7 @@ Graph::run_one()
 	}
 
 	while (to_run == 0) {
-		_execution_tokens += 1;
+		g_atomic_int_inc (&_execution_tokens);
 		pthread_mutex_unlock (&_trigger_mutex);
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
 		_execution_sem.wait ();
@@ -409,6 +545,10 @@ Graph::run_one()
 			return true;
 		}
 		DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
+		if (g_atomic_int_get (&_work_stealing)) {
+			/* woken up for a cycle using the work-stealing scheduler */
+			return false;
+		}
 		pthread_mutex_lock (&_trigger_mutex);
 		if (_trigger_queue.size()) {
 			to_run = _trigger_queue.back();
@@ -417,7 +557,9 @@ Graph::run_one()
 	}
 	pthread_mutex_unlock (&_trigger_mutex);
 
+	const int64_t t0 = g_get_monotonic_time ();
 	to_run->process();
+	to_run->update_cost (g_get_monotonic_time () - t0);
 	to_run->finish (_current_chain);
 
 	DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one()\n", pthread_name()));
@@ -425,17 +567,150 @@ Graph::run_one()
 	return !_threads_active;
 }
 
+/** Work-stealing variant of run_one(), used when Config->get_work_stealing_graph() is set.
+ *  @return true to quit, false to carry on.
+ */
+bool
+Graph::run_one_ws (uint32_t thread_id)
+{
+	GraphNode* to_run = ws_find_work (thread_id);
+
+	if (!to_run) {
+		/* announce that we are going to sleep, then look again:
+		 * a node may have been queued before the announcement was visible.
+		 */
+		g_atomic_int_inc (&_execution_tokens);
+
+		to_run = ws_find_work (thread_id);
+
+		if (!to_run) {
+			DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 goes to sleep\n", pthread_name()));
+			_execution_sem.wait ();
+			DEBUG_TRACE (DEBUG::ProcessThreads, string_compose ("%1 is awake\n", pthread_name()));
+			return !_threads_active;
+		}
+
+		/* take back the token, unless another thread already used it to wake us */
+		while (true) {
+			gint et = g_atomic_int_get (&_execution_tokens);
+			if (et <= 0) {
+				_execution_sem.wait ();
+				break;
+			}
+			if (g_atomic_int_compare_and_exchange (&_execution_tokens, et, et - 1)) {
+				break;
+			}
+		}
+	}
+
+	const int64_t t0 = g_get_monotonic_time ();
+	to_run->process();
+	to_run->update_cost (g_get_monotonic_time () - t0);
+	to_run->finish (_current_chain);
+
+	/* keep the last node triggered by this one for ourselves,
+	 * and let sleeping threads steal the others.
+	 */
+	guint pending = _work_queues[thread_id]->deque.read_space ();
+	if (pending > 1) {
+		ws_wakeup (pending - 1);
+	}
+
+	DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("%1 has finished run_one_ws()\n", pthread_name()));
+
+	return !_threads_active;
+}
+
+/** Find a node to run: first from our own deque, then our slice of the
+ *  initial nodes, then from other threads and finally the shared queue.
+ */
+GraphNode*
+Graph::ws_find_work (uint32_t thread_id)
+{
+	GraphNode* n;
+	WorkQueue* wq = _work_queues[thread_id];
+
+	if (wq->deque.pop (n)) {
+		return n;
+	}
+
+	if ((n = ws_claim_seed (wq)) != 0) {
+		return n;
+	}
+
+	const uint32_t n_queues = _work_queues.size ();
+
+	for (uint32_t i = 1; i < n_queues; ++i) {
+		WorkQueue* victim = _work_queues[(thread_id + i) % n_queues];
+		if ((n = ws_claim_seed (victim)) != 0) {
+			return n;
+		}
+		if (victim->deque.steal (n)) {
+			return n;
+		}
+	}
+
+	if (g_atomic_int_get (&_trigger_overflow) > 0) {
+		n = 0;
+		pthread_mutex_lock (&_trigger_mutex);
+		if (_trigger_queue.size ()) {
+			n = _trigger_queue.back ();
+			_trigger_queue.pop_back ();
+			g_atomic_int_add (&_trigger_overflow, -1);
+		}
+		pthread_mutex_unlock (&_trigger_mutex);
+		return n;
+	}
+
+	return 0;
+}
+
+GraphNode*
+Graph::ws_claim_seed (WorkQueue* wq)
+{
+	std::vector<GraphNode*> const& seeds (_init_trigger_seeds[_current_chain]);
+
+	/* check first, to not increment seed_pos without bounds */
+	if (g_atomic_int_get (&wq->seed_pos) >= g_atomic_int_get (&wq->seed_end)) {
+		return 0;
+	}
+
+	gint pos = g_atomic_int_add (&wq->seed_pos, 1);
+
+	if (pos < g_atomic_int_get (&wq->seed_end) && pos < (gint) seeds.size ()) {
+		return seeds[pos];
+	}
+	return 0;
+}
+
+/** Wake up to @param n_tasks sleeping threads */
+void
+Graph::ws_wakeup (int n_tasks)
+{
+	while (n_tasks > 0) {
+		gint et = g_atomic_int_get (&_execution_tokens);
+		if (et <= 0) {
+			break;
+		}
+		if (g_atomic_int_compare_and_exchange (&_execution_tokens, et, et - 1)) {
+			_execution_sem.signal ();
+			--n_tasks;
+		}
+	}
+}
+
 void
-Graph::helper_thread()
+Graph::helper_thread (uint32_t thread_id)
 {
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 	resume_rt_malloc_checks ();
 
 	pt->get_buffers();
+	_thread_work_queue.set (_work_queues[thread_id]);
 
 	while(1) {
-		if (run_one()) {
+		if (run_one (thread_id)) {
 			break;
 		}
 	}
@@ -453,6 +728,7 @@ Graph::main_thread()
 	resume_rt_malloc_checks ();
 
 	pt->get_buffers();
+	_thread_work_queue.set (_work_queues[0]);
 
 again:
 	_callback_start_sem.wait ();
@@ -476,7 +752,7 @@ again:
 	/* This loop will run forever */
 	while (1) {
 		DEBUG_TRACE(DEBUG::ProcessThreads, string_compose ("main thread (%1) runs one graph node\n", pthread_name ()));
-		if (run_one()) {
+		if (run_one (0)) {
 			break;
 		}
 	}
@@ -26,6 +26,8 @@ using namespace ARDOUR;
 
 GraphNode::GraphNode (boost::shared_ptr<Graph> graph)
 	: _graph(graph)
+	, _cost (0)
+	, _priority (0)
 {
 }
 
@@ -72,6 +74,12 @@ GraphNode::finish (int chain)
 	}
 }
 
+void
+GraphNode::update_cost (int64_t usec)
+{
+	/* exponential moving average over roughly 16 cycles */
+	_cost += ((float) usec - _cost) * .0625f;
+}
 
 void
 GraphNode::process()
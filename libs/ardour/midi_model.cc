@@ -1493,6 +1493,11 @@ MidiModel::resolve_overlaps_unlocked (const NotePtr note, void* arg)
 		TimeType eb = (*i)->end_time();
 		OverlapType overlap = OverlapNone;
 
+		if (sb > ea) {
+			/* pitches are sorted by time, none of the remaining notes can overlap */
+			break;
+		}
+
 		if ((sb > sa) && (eb <= ea)) {
 			overlap = OverlapInternal;
 		} else if ((eb > sa) && (eb <= ea)) {
@@ -142,6 +142,30 @@ default_copy_vector (ARDOUR::Sample * dst, const ARDOUR::Sample * src, pframes_t
 	memcpy(dst, src, nframes*sizeof(ARDOUR::Sample));
 }
 
+void
+default_mix_buffers_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] += src[i] * (gain[i] * scale);
+	}
+}
+
+void
+default_copy_vector_with_gain_curve (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] = src[i] * (gain[i] * scale);
+	}
+}
+
+void
+default_crossfade_buffers (ARDOUR::Sample * dst, const ARDOUR::Sample * src, const float * gain, float scale, pframes_t nframes)
+{
+	for (pframes_t i = 0; i < nframes; i++) {
+		dst[i] = dst[i] * (1.f - gain[i]) + src[i] * (gain[i] * scale);
+	}
+}
+
 #if defined (__APPLE__) && defined (BUILD_VECLIB_OPTIMIZATIONS)
 #include <Accelerate/Accelerate.h>
 
@@ -305,6 +305,10 @@ Playlist::init (bool hide)
 
 	g_atomic_int_set (&block_notifications, 0);
 	g_atomic_int_set (&ignore_state_changes, 0);
+	g_atomic_int_set (&_region_index_dirty, 1);
+	g_atomic_int_set (&_state_serial, 0);
+	_cached_state = 0;
+	_cached_state_serial = 0;
 	pending_contents_change = false;
 	pending_layering = false;
 	first_set_state = true;
@@ -343,6 +347,8 @@ Playlist::~Playlist ()
 		}
 	}
 
+	delete _cached_state;
+
 	/* GoingAway must be emitted by derived classes */
 }
 
@@ -384,6 +390,7 @@ Playlist::set_name (const string& str)
 	bool ret =  SessionObject::set_name(str);
 	if (ret) {
 		_set_sort_id ();
+		invalidate_state_cache ();
 	}
 	return ret;
 }
@@ -759,6 +766,7 @@ Playlist::add_region_internal (boost::shared_ptr<Region> region, samplepos_t pos
 
 	regions.insert (upper_bound (regions.begin(), regions.end(), region, cmp), region);
 	all_regions.insert (region);
+	invalidate_region_index ();
 
 	possibly_splice_unlocked (position, region->length(), region);
 
@@ -820,6 +828,7 @@ Playlist::remove_region_internal (boost::shared_ptr<Region> region)
 			samplecnt_t distance = (*i)->length();
 
 			regions.erase (i);
+			invalidate_region_index ();
 
 			possibly_splice_unlocked (pos, -distance);
 
@@ -1704,6 +1713,10 @@ Playlist::region_bounds_changed (const PropertyChange& what_changed, boost::shar
 		 return;
 	 }
 
+	 if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+		 invalidate_region_index ();
+	 }
+
 	 /* this makes a virtual call to the right kind of playlist ... */
 
 	 region_changed (what_changed, region);
@@ -1846,6 +1859,11 @@ Playlist::regions_at (samplepos_t sample)
 	 RegionReadLock rlock (const_cast<Playlist*>(this));
 	 uint32_t cnt = 0;
 
+	 RegionList touched;
+	 if (regions_touched_indexed (sample, sample, touched)) {
+		 return touched.size ();
+	 }
+
 	 for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
 		 if ((*i)->covers (sample)) {
 			 cnt++;
@@ -1910,6 +1928,10 @@ Playlist::find_regions_at (samplepos_t sample)
 
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (regions_touched_indexed (sample, sample, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 		if ((*i)->covers (sample)) {
 			rlist->push_back (*i);
@@ -1919,12 +1941,37 @@ Playlist::find_regions_at (samplepos_t sample)
 	return rlist;
 }
 
+namespace {
+
+/** Playlists with fewer regions than this are searched linearly */
+const size_t region_index_threshold = 64;
+
+struct RegionIndexFirstLess {
+	template<typename Entry>
+	bool operator() (Entry const& a, Entry const& b) const { return a.first < b.first; }
+	template<typename Entry>
+	bool operator() (Entry const& a, samplepos_t b) const { return a.first < b; }
+};
+
+}
+
 boost::shared_ptr<RegionList>
 Playlist::regions_with_start_within (Evoral::Range<samplepos_t> range)
 {
 	RegionReadLock rlock (this);
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (update_region_index ()) {
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		std::vector<RegionIndexEntry>::const_iterator i = lower_bound (_region_index.begin(), _region_index.end(), range.from, RegionIndexFirstLess ());
+		for (; i != _region_index.end() && i->first <= range.to; ++i) {
+			if (i->region->first_sample() >= range.from && i->region->first_sample() <= range.to) {
+				rlist->push_back (i->region);
+			}
+		}
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 		if ((*i)->first_sample() >= range.from && (*i)->first_sample() <= range.to) {
 			rlist->push_back (*i);
@@ -1965,6 +2012,10 @@ Playlist::regions_touched_locked (samplepos_t start, samplepos_t end)
 {
 	boost::shared_ptr<RegionList> rlist (new RegionList);
 
+	if (regions_touched_indexed (start, end, *rlist)) {
+		return rlist;
+	}
+
 	for (RegionList::iterator i = regions.begin(); i != regions.end(); ++i) {
 		if ((*i)->coverage (start, end) != Evoral::OverlapNone) {
 			rlist->push_back (*i);
@@ -1974,6 +2025,108 @@ Playlist::regions_touched_locked (samplepos_t start, samplepos_t end)
 	return rlist;
 }
 
+/** Bring the region index up to date; the caller must hold the region lock.
+ *  @return true if the index should be used for queries.
+ */
+bool
+Playlist::update_region_index () const
+{
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+
+	if (g_atomic_int_compare_and_exchange (&_region_index_dirty, 1, 0)) {
+		rebuild_region_index ();
+	}
+
+	return _region_index.size () >= region_index_threshold;
+}
+
+void
+Playlist::rebuild_region_index () const
+{
+	_region_index.clear ();
+
+	for (RegionList::const_iterator i = regions.begin(); i != regions.end(); ++i) {
+		RegionIndexEntry e;
+		e.first = (*i)->first_sample ();
+		e.max_last = (*i)->last_sample ();
+		e.region = *i;
+		_region_index.push_back (e);
+	}
+
+	/* the list is normally sorted already, but region moves may not have
+	 * been processed yet.
+	 */
+	stable_sort (_region_index.begin(), _region_index.end(), RegionIndexFirstLess ());
+
+	build_region_index_tree (0, _region_index.size ());
+}
+
+/** The index is an implicit binary tree over the sorted array: the root
+ *  of [lo, hi) is at its middle. Replace each entry's max_last with the
+ *  maximum last sample of the subtree rooted at it.
+ *  @return the maximum last sample in [lo, hi)
+ */
+samplepos_t
+Playlist::build_region_index_tree (size_t lo, size_t hi) const
+{
+	if (lo >= hi) {
+		return -1;
+	}
+
+	size_t const mid = lo + (hi - lo) / 2;
+	RegionIndexEntry& e (_region_index[mid]);
+
+	e.max_last = max (e.max_last, build_region_index_tree (lo, mid));
+	e.max_last = max (e.max_last, build_region_index_tree (mid + 1, hi));
+
+	return e.max_last;
+}
+
+void
+Playlist::region_index_touched (size_t lo, size_t hi, samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	while (lo < hi) {
+
+		size_t const mid = lo + (hi - lo) / 2;
+		RegionIndexEntry const& e (_region_index[mid]);
+
+		if (e.max_last < start) {
+			/* nothing in this subtree reaches the range */
+			return;
+		}
+
+		region_index_touched (lo, mid, start, end, rl);
+
+		if (e.first > end) {
+			/* everything to the right starts after the range */
+			return;
+		}
+
+		if (e.region->coverage (start, end) != Evoral::OverlapNone) {
+			rl.push_back (e.region);
+		}
+
+		lo = mid + 1;
+	}
+}
+
+/** Find regions touching [start, end] via the region index; the caller
+ *  must hold the region lock. Regions are appended to @param rl in
+ *  position order.
+ *  @return false if the playlist is too small to use the index.
+ */
+bool
+Playlist::regions_touched_indexed (samplepos_t start, samplepos_t end, RegionList& rl) const
+{
+	if (!update_region_index ()) {
+		return false;
+	}
+
+	Glib::Threads::Mutex::Lock lm (_region_index_lock);
+	region_index_touched (0, _region_index.size (), start, end, rl);
+	return true;
+}
+
 samplepos_t
 Playlist::find_next_transient (samplepos_t from, int dir)
 {
@@ -2216,6 +2369,8 @@ Playlist::find_next_region (samplepos_t sample, RegionPoint point, int dir)
  int
  Playlist::set_state (const XMLNode& node, int version)
  {
+	 invalidate_state_cache ();
+
 	 XMLNode *child;
 	 XMLNodeList nlist;
 	 XMLNodeConstIterator niter;
@@ -2331,6 +2486,57 @@ Playlist::get_template()
 	return state (false);
 }
 
+XMLNode&
+Playlist::cached_state (bool reuse)
+{
+	gint const serial = g_atomic_int_get (&_state_serial);
+
+	if (!reuse || !_cached_state || serial != _cached_state_serial) {
+		delete _cached_state;
+		_cached_state = &state (true);
+		/* extra XML can change without notice, it is added below */
+		_cached_state->remove_nodes_and_delete (X_("Extra"));
+		_cached_state_serial = serial;
+	}
+
+	XMLNode* node = new XMLNode (*_cached_state);
+
+	/* so can that of our regions, whose Extra node is refreshed in place.
+	 * Region nodes are in the order of the region list, which has not
+	 * changed since they were cached (RegionWriteLock bumps the serial).
+	 */
+	bool extra_added_or_removed = false;
+	{
+		RegionReadLock rlock (this);
+		XMLNodeList const& children (node->children ());
+		XMLNodeConstIterator c = children.begin();
+		for (RegionList::const_iterator i = regions.begin(); i != regions.end() && c != children.end(); ++i, ++c) {
+			XMLNode const* extra = (*i)->extra_xml_node ();
+			XMLNode* cached_extra = (*c)->child (X_("Extra"));
+			if (!extra != !cached_extra) {
+				extra_added_or_removed = true;
+				break;
+			}
+			if (extra) {
+				*cached_extra = *extra;
+			}
+		}
+	}
+
+	if (extra_added_or_removed) {
+		/* the node's position within the region state is unknown */
+		delete node;
+		invalidate_state_cache ();
+		return cached_state (reuse);
+	}
+
+	if (_extra_xml) {
+		node->add_child_copy (*_extra_xml);
+	}
+
+	return *node;
+}
+
 /** @param full_state true to include regions in the returned state, otherwise false.
  */
 XMLNode&
@@ -2833,6 +3039,7 @@ void
 Playlist::set_frozen (bool yn)
 {
 	_frozen = yn;
+	invalidate_state_cache ();
 }
 
 void
@@ -2996,6 +3203,11 @@ Playlist::has_region_at (samplepos_t const p) const
 {
 	RegionReadLock (const_cast<Playlist *> (this));
 
+	RegionList touched;
+	if (regions_touched_indexed (p, p, touched)) {
+		return !touched.empty ();
+	}
+
 	RegionList::const_iterator i = regions.begin ();
 	while (i != regions.end() && !(*i)->covers (p)) {
 		++i;
@@ -3016,6 +3228,17 @@ Playlist::find_next_top_layer_position (samplepos_t t) const
 
 	layer_t const top = top_layer ();
 
+	if (update_region_index ()) {
+		Glib::Threads::Mutex::Lock lm (_region_index_lock);
+		std::vector<RegionIndexEntry>::const_iterator i = lower_bound (_region_index.begin(), _region_index.end(), t, RegionIndexFirstLess ());
+		for (; i != _region_index.end(); ++i) {
+			if (i->region->position() >= t && i->region->layer() == top) {
+				return i->region->position();
+			}
+		}
+		return max_samplepos;
+	}
+
 	RegionList copy = regions.rlist ();
 	copy.sort (RegionSortByPosition ());
 
@@ -3152,6 +3375,7 @@ Playlist::combine (const RegionList& r)
 	add_region (compound_region, earliest_position);
 
 	_combine_ops++;
+	invalidate_state_cache ();
 
 	thaw ();
 
@@ -3361,6 +3585,7 @@ Playlist::set_orig_track_id (const PBD::ID& id)
 		share_with (_orig_track_id);
 	}
 	_orig_track_id = id;
+	invalidate_state_cache ();
 }
 
 void
@@ -3368,6 +3593,7 @@ Playlist::share_with (const PBD::ID& id)
 {
 	if (!shared_with(id)) {
 		_shared_with_ids.push_back (id);
+		invalidate_state_cache ();
 	}
 }
 
@@ -3378,6 +3604,7 @@ Playlist::unshare_with (const PBD::ID& id)
 	while (it != _shared_with_ids.end()) {
 		if (*it == id) {
 			_shared_with_ids.erase (it);
+			invalidate_state_cache ();
 			break;
 		}
 		++it;
@@ -3403,6 +3630,7 @@ void
 Playlist::reset_shares ()
 {
 	_shared_with_ids.clear();
+	invalidate_state_cache ();
 }
 
 /** Take a list of ranges, coalesce any that can be coalesced, then call
@@ -21,6 +21,7 @@
 #include "libardour-config.h"
 #endif
 
+#include <set>
 #include <string>
 
 #include "pbd/failed_constructor.h"
@@ -37,6 +38,8 @@
 #include "ardour/plugin.h"
 #include "ardour/plugin_insert.h"
 #include "ardour/port.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/rt_tasklist.h"
 
 #ifdef LV2_SUPPORT
 #include "ardour/lv2_plugin.h"
@@ -78,10 +81,12 @@ PluginInsert::PluginInsert (Session& s, boost::shared_ptr<Plugin> plug)
 	, _signal_analysis_collect_nframes_max(0)
 	, _configured (false)
 	, _no_inplace (false)
+	, _replicas_independent (false)
 	, _strict_io (false)
 	, _custom_cfg (false)
 	, _maps_from_state (false)
 	, _latency_changed (false)
+	, _replica_failed (0)
 	, _bypass_port (UINT32_MAX)
 {
 	/* the first is the master */
@@ -1014,11 +1019,23 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 		}
 	} else {
 		/* in-place processing */
-		uint32_t pc = 0;
-		for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
-			if ((*i)->connect_and_run(bufs, start, end, speed, in_map[pc], out_map[pc], nframes, offset)) {
+		boost::shared_ptr<RTTaskList> tl = _session.rt_tasklist ();
+		if (_replicas_independent && tl && _replica_tasks.size () == _plugins.size () && bufs.count().n_midi () == 0 && Config->get_parallel_plugin_replicas ()) {
+			/* every replica only touches its own buffers, fan them out */
+			ReplicaCycle rc = { &bufs, start, end, speed, &in_map, &out_map, nframes, offset };
+			_replica_cycle = rc;
+			g_atomic_int_set (&_replica_failed, 0);
+			tl->process (_replica_tasks, _replica_batch);
+			if (g_atomic_int_get (&_replica_failed)) {
 				deactivate ();
 			}
+		} else {
+			uint32_t pc = 0;
+			for (Plugins::iterator i = _plugins.begin(); i != _plugins.end(); ++i, ++pc) {
+				if ((*i)->connect_and_run(bufs, start, end, speed, in_map[pc], out_map[pc], nframes, offset)) {
+					deactivate ();
+				}
+			}
 		}
 		// now silence unconnected outputs
 		inplace_silence_unconnected (bufs, _out_map, nframes, offset);
@@ -1056,6 +1073,35 @@ PluginInsert::connect_and_run (BufferSet& bufs, samplepos_t start, samplepos_t e
 	}
 }
 
+/** Build the tasks that run the replicas in parallel. This is done once
+ * per configuration (with the process lock held) rather than in every
+ * connect_and_run().
+ */
+void
+PluginInsert::setup_replica_tasks ()
+{
+	_replica_tasks.clear ();
+	if (get_count () < 2) {
+		return;
+	}
+	_replica_tasks.reserve (get_count ());
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		_replica_tasks.push_back (boost::bind (&PluginInsert::run_replica, this, pc));
+	}
+}
+
+void
+PluginInsert::run_replica (uint32_t pc)
+{
+	/* called from RTTaskList threads, concurrently for all replicas */
+	ReplicaCycle const& rc (_replica_cycle);
+	if (_plugins[pc]->connect_and_run (*rc.bufs, rc.start, rc.end, rc.speed,
+	                                   rc.in_map->find (pc)->second, rc.out_map->find (pc)->second,
+	                                   rc.nframes, rc.offset)) {
+		g_atomic_int_set (&_replica_failed, 1);
+	}
+}
+
 void
 PluginInsert::bypass (BufferSet& bufs, pframes_t nframes)
 {
@@ -1416,6 +1462,7 @@ PluginInsert::set_input_map (uint32_t num, ChanMapping m) {
 		changed |= sanitize_maps ();
 		if (changed) {
 			PluginMapChanged (); /* EMIT SIGNAL */
+			_replicas_independent = check_replicas_independent (check_inplace ());
 			_mapping_changed = true;
 			_session.set_dirty();
 		}
@@ -1430,6 +1477,7 @@ PluginInsert::set_output_map (uint32_t num, ChanMapping m) {
 		changed |= sanitize_maps ();
 		if (changed) {
 			PluginMapChanged (); /* EMIT SIGNAL */
+			_replicas_independent = check_replicas_independent (check_inplace ());
 			_mapping_changed = true;
 			_session.set_dirty();
 		}
@@ -1443,6 +1491,7 @@ PluginInsert::set_thru_map (ChanMapping m) {
 	changed |= sanitize_maps ();
 	if (changed) {
 		PluginMapChanged (); /* EMIT SIGNAL */
+		_replicas_independent = check_replicas_independent (check_inplace ());
 		_mapping_changed = true;
 		_session.set_dirty();
 	}
@@ -1635,6 +1684,55 @@ PluginInsert::check_inplace ()
 	return !inplace_ok; // no-inplace
 }
 
+/** @return true if replicated instances can be run concurrently:
+ * in-place processing without MIDI, and no buffer is used by more
+ * than one instance. This is not realtime safe, call it when the
+ * mapping changes rather than from the process thread.
+ * @param no_inplace as returned by check_inplace() for the current mapping
+ */
+bool
+PluginInsert::check_replicas_independent (bool no_inplace) const
+{
+	if (get_count () < 2 || no_inplace) {
+		return false;
+	}
+	if (natural_input_streams ().n_midi () > 0 || natural_output_streams ().n_midi () > 0) {
+		return false;
+	}
+
+	std::set<uint32_t> used;
+	for (uint32_t pc = 0; pc < get_count (); ++pc) {
+		PinMappings::const_iterator im = _in_map.find (pc);
+		PinMappings::const_iterator om = _out_map.find (pc);
+		if (im == _in_map.end () || om == _out_map.end ()) {
+			return false;
+		}
+		std::set<uint32_t> mine;
+		for (uint32_t in = 0; in < natural_input_streams ().n_audio (); ++in) {
+			bool valid;
+			uint32_t idx = im->second.get (DataType::AUDIO, in, &valid);
+			if (valid) {
+				mine.insert (idx);
+			}
+		}
+		for (uint32_t out = 0; out < natural_output_streams ().n_audio (); ++out) {
+			bool valid;
+			uint32_t idx = om->second.get (DataType::AUDIO, out, &valid);
+			if (valid) {
+				mine.insert (idx);
+			}
+		}
+		for (std::set<uint32_t>::const_iterator i = mine.begin (); i != mine.end (); ++i) {
+			if (!used.insert (*i).second) {
+				return false;
+			}
+		}
+	}
+
+	DEBUG_TRACE (DEBUG::ChanMapping, string_compose ("%1: replicas are independent\n", name()));
+	return true;
+}
+
 bool
 PluginInsert::sanitize_maps ()
 {
@@ -1806,6 +1904,7 @@ PluginInsert::reset_map (bool emit)
 	}
 	if (emit) {
 		PluginMapChanged (); /* EMIT SIGNAL */
+		_replicas_independent = check_replicas_independent (check_inplace ());
 		_mapping_changed = true;
 		_session.set_dirty();
 	}
@@ -1999,7 +2098,9 @@ PluginInsert::configure_io (ChanCount in, ChanCount out)
 	}
 
 	_no_inplace = check_inplace ();
+	_replicas_independent = check_replicas_independent (_no_inplace);
 	_mapping_changed = false;
+	setup_replica_tasks ();
 
 	/* only the "noinplace_buffers" thread buffers need to be this large,
 	 * this can be optimized. other buffers are fine with
@@ -53,8 +53,14 @@ PortManager::PortManager ()
 	: ports (new Ports)
 	, _port_remove_in_progress (false)
 	, _port_deletions_pending (8192) /* ick, arbitrary sizing */
+	, _cycle_ports (0)
+	, _cycle_plans (new CyclePorts ())
+	, _cycle_plan (0)
+	, _cycle_plan_nframes (0)
+	, _cycle_plan_dirty (1)
 	, midi_info_dirty (true)
 {
+	update_cycle_ports ();
 	load_midi_port_info ();
 }
 
@@ -63,6 +69,11 @@ PortManager::clear_pending_port_deletions ()
 {
 	Port* p;
 
+	/* called from the session's auto-connect thread after ports were
+	 * added or removed, which is a good time to catch up.
+	 */
+	update_cycle_ports ();
+
 	DEBUG_TRACE (DEBUG::Ports, string_compose ("pending port deletions: %1\n", _port_deletions_pending.read_space()));
 
 	while (_port_deletions_pending.read (&p, 1) == 1) {
@@ -88,6 +99,8 @@ PortManager::remove_all_ports ()
 		ps->clear ();
 	}
 
+	g_atomic_int_set (&_cycle_plan_dirty, 1);
+
 	/* clear dead wood list in RCU */
 
 	ports.flush ();
@@ -306,15 +319,19 @@ PortManager::get_port_by_name (const string& portname)
 void
 PortManager::port_renamed (const std::string& old_relative_name, const std::string& new_relative_name)
 {
-	RCUWriter<Ports> writer (ports);
-	boost::shared_ptr<Ports> p = writer.get_copy();
-	Ports::iterator x = p->find (old_relative_name);
+	{
+		RCUWriter<Ports> writer (ports);
+		boost::shared_ptr<Ports> p = writer.get_copy();
+		Ports::iterator x = p->find (old_relative_name);
 
-	if (x != p->end()) {
-		boost::shared_ptr<Port> port = x->second;
-		p->erase (x);
-		p->insert (make_pair (new_relative_name, port));
+		if (x != p->end()) {
+			boost::shared_ptr<Port> port = x->second;
+			p->erase (x);
+			p->insert (make_pair (new_relative_name, port));
+		}
 	}
+
+	g_atomic_int_set (&_cycle_plan_dirty, 1);
 }
 
 int
@@ -403,12 +420,15 @@ PortManager::register_port (DataType dtype, const string& portname, bool input,
 			throw PortRegistrationFailure("unable to create port (unknown type)");
 		}
 
-		RCUWriter<Ports> writer (ports);
-		boost::shared_ptr<Ports> ps = writer.get_copy ();
-		ps->insert (make_pair (make_port_name_relative (portname), newport));
+		{
+			RCUWriter<Ports> writer (ports);
+			boost::shared_ptr<Ports> ps = writer.get_copy ();
+			ps->insert (make_pair (make_port_name_relative (portname), newport));
 
-		/* writer goes out of scope, forces update */
+			/* writer goes out of scope, forces update */
+		}
 
+		g_atomic_int_set (&_cycle_plan_dirty, 1);
 	}
 
 	catch (PortRegistrationFailure& err) {
@@ -460,6 +480,8 @@ PortManager::unregister_port (boost::shared_ptr<Port> port)
 		/* writer goes out of scope, forces update */
 	}
 
+	g_atomic_int_set (&_cycle_plan_dirty, 1);
+
 	ports.flush ();
 
 	return 0;
@@ -617,6 +639,8 @@ PortManager::reestablish_ports ()
 		return -1;
 	}
 
+	update_cycle_ports ();
+
 	return 0;
 }
 
@@ -635,6 +659,8 @@ PortManager::reconnect_ports ()
 		}
 	}
 
+	update_cycle_ports ();
+
 	return 0;
 }
 
@@ -745,39 +771,133 @@ PortManager::graph_order_callback ()
 	return 0;
 }
 
+static void
+ports_cycle_start (std::vector<Port*> const* pl, pframes_t const* nframes)
+{
+	for (std::vector<Port*>::const_iterator p = pl->begin(); p != pl->end(); ++p) {
+		(*p)->cycle_start (*nframes);
+	}
+}
+
+static void
+ports_cycle_end (std::vector<Port*> const* pl, pframes_t const* nframes)
+{
+	for (std::vector<Port*>::const_iterator p = pl->begin(); p != pl->end(); ++p) {
+		(*p)->cycle_end (*nframes);
+	}
+}
+
+static void
+port_cycle_start (Port* p, pframes_t const* nframes)
+{
+	p->cycle_start (*nframes);
+}
+
+static void
+port_cycle_end (Port* p, pframes_t const* nframes)
+{
+	p->cycle_end (*nframes);
+}
+
+/** Rebuild the cycle plan if ports changed since it was last built. Ports
+ * are usually added or removed in batches, this is called once per batch
+ * from a non-realtime thread. Until then, the process callback falls back
+ * to walking the port map.
+ */
+void
+PortManager::update_cycle_ports ()
+{
+	if (!g_atomic_int_compare_and_exchange (&_cycle_plan_dirty, 1, 0)) {
+		return;
+	}
+
+	RCUWriter<CyclePorts> writer (_cycle_plans);
+	boost::shared_ptr<CyclePorts> cp = writer.get_copy ();
+
+	/* read the port map while holding the writer lock, so that the
+	 * last plan written always describes the most recent map.
+	 */
+	boost::shared_ptr<Ports> pr = ports.reader ();
+
+	*cp = CyclePorts ();
+	cp->ports = pr.get ();
+	cp->ports_alive = pr;
+
+	for (Ports::const_iterator i = pr->begin(); i != pr->end(); ++i) {
+		Port* p = i->second.get ();
+		cp->all.push_back (p);
+
+		if (p->type () != DataType::AUDIO) {
+			/* MIDI ports only scale event timestamps */
+			cp->start_light.push_back (p);
+			cp->end_light.push_back (p);
+		} else if (p->receives_input ()) {
+			cp->start_heavy.push_back (p);
+			cp->end_light.push_back (p);
+		} else {
+			/* output ports only set a flag in cycle_start */
+			cp->start_light.push_back (p);
+			cp->end_heavy.push_back (p);
+		}
+	}
+
+	/* the light group runs as a single task in parallel with the
+	 * resamplers. With less than two resamplers, the semaphore
+	 * synchronization costs more than it gains: run in sequence.
+	 */
+	if (cp->start_heavy.size () > 1) {
+		cp->start_tasks.push_back (boost::bind (&ports_cycle_start, &cp->start_light, &_cycle_plan_nframes));
+		for (std::vector<Port*>::const_iterator p = cp->start_heavy.begin(); p != cp->start_heavy.end(); ++p) {
+			cp->start_tasks.push_back (boost::bind (&port_cycle_start, *p, &_cycle_plan_nframes));
+		}
+	}
+
+	if (cp->end_heavy.size () > 1) {
+		cp->end_tasks.push_back (boost::bind (&ports_cycle_end, &cp->end_light, &_cycle_plan_nframes));
+		for (std::vector<Port*>::const_iterator p = cp->end_heavy.begin(); p != cp->end_heavy.end(); ++p) {
+			cp->end_tasks.push_back (boost::bind (&port_cycle_end, *p, &_cycle_plan_nframes));
+		}
+	}
+}
+
 void
 PortManager::cycle_start (pframes_t nframes, Session* s)
 {
 	Port::set_global_port_buffer_offset (0);
 	Port::set_cycle_samplecnt (nframes);
 
-	_cycle_ports = ports.reader ();
+	_cycle_ports = ports.rt_reader ();
+	_cycle_plan = _cycle_plans.rt_reader ();
+
+	if (_cycle_plan->ports != _cycle_ports || _cycle_plan->ports_alive.expired ()) {
+		/* ports were (un)registered since the plan was built. The
+		 * second test guards against a new map at the address of the
+		 * (free'd) one the plan was built from.
+		 */
+		_cycle_plan = 0;
+	}
 
-	/* TODO optimize
-	 *  - when speed == 1.0, the resampler copies data without processing
-	 *   it may (or may not) be more efficient to just run all in sequence.
+	/* Port lists and task lists are precomputed after ports change
+	 * (see ::update_cycle_ports()), nothing here allocates.
 	 *
-	 *  - single sequential task for 'lightweight' tasks would make sense
-	 *    (run it in parallel with 'heavy' resampling.
-	 *    * output ports (sends_output()) only set a flag
-	 *    * midi-ports only scale event timestamps
+	 * - when speed == 1.0, the resampler copies data without processing;
+	 *   all ports run in sequence.
 	 *
-	 *  - a threshold parallel vs searial processing may be appropriate.
-	 *    amount of work (how many connected ports are there, how
-	 *    many resamplers need to run) vs. available CPU cores and semaphore
-	 *    synchronization overhead.
+	 * - 'lightweight' ports run as a single sequential task in parallel
+	 *   with the 'heavy' resampling of each audio input.
 	 *
-	 *  - input ports: it would make sense to resample each input only once
+	 * TODO input ports: it would make sense to resample each input only once
 	 *    (rather than resample into each ardour-owned input port).
 	 *    A single external source-port may be connected to many ardour
 	 *    input-ports. Currently re-sampling is per input.
 	 */
-	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			tl.push_back (boost::bind (&Port::cycle_start, p->second, nframes));
+	if (_cycle_plan) {
+		if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0 && !_cycle_plan->start_tasks.empty ()) {
+			_cycle_plan_nframes = nframes;
+			s->rt_tasklist()->process (_cycle_plan->start_tasks);
+		} else {
+			ports_cycle_start (&_cycle_plan->all, &nframes);
 		}
-		s->rt_tasklist()->process (tl);
 	} else {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 			p->second->cycle_start (nframes);
@@ -786,26 +906,34 @@ PortManager::cycle_start (pframes_t nframes, Session* s)
 }
 
 void
-PortManager::cycle_end (pframes_t nframes, Session* s)
+PortManager::run_cycle_end (pframes_t nframes, Session* s)
 {
 	// see optimzation note in ::cycle_start()
-	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			tl.push_back (boost::bind (&Port::cycle_end, p->second, nframes));
+	if (_cycle_plan) {
+		if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0 && !_cycle_plan->end_tasks.empty ()) {
+			_cycle_plan_nframes = nframes;
+			s->rt_tasklist()->process (_cycle_plan->end_tasks);
+		} else {
+			ports_cycle_end (&_cycle_plan->all, &nframes);
 		}
-		s->rt_tasklist()->process (tl);
 	} else {
 		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 			p->second->cycle_end (nframes);
 		}
 	}
+}
+
+void
+PortManager::cycle_end (pframes_t nframes, Session* s)
+{
+	run_cycle_end (nframes, s);
 
 	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 		p->second->flush_buffers (nframes);
 	}
 
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
+	_cycle_plan = 0;
 
 	/* we are done */
 }
@@ -891,18 +1019,7 @@ PortManager::check_monitoring ()
 void
 PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t nframes, Session* s)
 {
-	// see optimzation note in ::cycle_start()
-	if (s && s->rt_tasklist () && fabs (Port::speed_ratio ()) != 1.0) {
-		RTTaskList::TaskList tl;
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			tl.push_back (boost::bind (&Port::cycle_end, p->second, nframes));
-		}
-		s->rt_tasklist()->process (tl);
-	} else {
-		for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
-			p->second->cycle_end (nframes);
-		}
-	}
+	run_cycle_end (nframes, s);
 
 	for (Ports::iterator p = _cycle_ports->begin(); p != _cycle_ports->end(); ++p) {
 		p->second->flush_buffers (nframes);
@@ -921,7 +1038,8 @@ PortManager::cycle_end_fade_out (gain_t base_gain, gain_t gain_step, pframes_t n
 			}
 		}
 	}
-	_cycle_ports.reset ();
+	_cycle_ports = 0;
+	_cycle_plan = 0;
 	/* we are done */
 }
 
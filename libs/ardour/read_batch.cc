@@ -0,0 +1,96 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <algorithm>
+
+#include "pbd/compose.h"
+
+#include "ardour/audiofilesource.h"
+#include "ardour/debug.h"
+#include "ardour/read_batch.h"
+
+using namespace ARDOUR;
+using namespace std;
+
+bool
+ReadBatch::RequestSorter::operator() (Request const& a, Request const& b) const
+{
+	if (a.source == b.source) {
+		return a.start < b.start;
+	}
+	int const c = a.source->path().compare (b.source->path());
+	if (c != 0) {
+		return c < 0;
+	}
+	return a.start < b.start;
+}
+
+void
+ReadBatch::add (boost::shared_ptr<AudioFileSource> source, samplepos_t start, samplecnt_t cnt)
+{
+	if (!source || cnt <= 0) {
+		return;
+	}
+	_requests.push_back (Request (source, start, cnt));
+}
+
+void
+ReadBatch::coalesce ()
+{
+	sort (_requests.begin (), _requests.end (), RequestSorter ());
+
+	vector<Request>::iterator merged = _requests.begin ();
+	vector<Request>::const_iterator i = _requests.begin ();
+
+	while (i != _requests.end ()) {
+
+		Request r (*i);
+		samplepos_t end = r.start + r.cnt;
+
+		/* the channels of a multi-channel file share its path */
+		for (++i; i != _requests.end () && i->start <= end && (i->source == r.source || i->source->path () == r.source->path ()); ++i) {
+			end = max (end, i->start + i->cnt);
+		}
+
+		r.cnt = end - r.start;
+		*merged++ = r;
+	}
+
+	_requests.erase (merged, _requests.end ());
+}
+
+void
+ReadBatch::submit ()
+{
+	if (_requests.empty ()) {
+		return;
+	}
+
+	size_t const n_reads = _requests.size ();
+
+	coalesce ();
+
+	for (vector<Request>::const_iterator i = _requests.begin (); i != _requests.end (); ++i) {
+		i->source->prefetch (i->start, i->cnt);
+	}
+
+	DEBUG_TRACE (DEBUG::DiskIO, string_compose ("read batch: %1 reads merged into %2 prefetches\n", n_reads, _requests.size ()));
+
+	_requests.clear ();
+}
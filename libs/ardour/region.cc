@@ -1433,6 +1433,18 @@ Region::send_change (const PropertyChange& what_changed)
 		return;
 	}
 
+	/* the playlist's region index and cached state must not wait until the
+	 * change is signalled, which is deferred while property changes are
+	 * suspended. This is also called again with the pending changes on thaw.
+	 */
+	boost::shared_ptr<Playlist> pl (playlist());
+	if (pl) {
+		if (what_changed.contains (Properties::position) || what_changed.contains (Properties::length)) {
+			pl->invalidate_region_index ();
+		}
+		pl->invalidate_state_cache ();
+	}
+
 	Stateful::send_change (what_changed);
 
 	if (!Stateful::property_changes_suspended()) {
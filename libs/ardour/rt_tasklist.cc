@@ -21,6 +21,7 @@
 
 #include "ardour/audioengine.h"
 #include "ardour/debug.h"
+#include "ardour/process_thread.h"
 #include "ardour/rt_tasklist.h"
 #include "ardour/utils.h"
 
@@ -28,10 +29,18 @@
 
 using namespace ARDOUR;
 
+RTTaskList::Batch::Batch ()
+	: _tasks (0)
+	, _next (0)
+	, _pending (0)
+	, _done ("rt_task_done", 0)
+{
+}
+
 RTTaskList::RTTaskList ()
 	: _threads_active (0)
 	, _task_run_sem ("rt_task_run", 0)
-	, _task_end_sem ("rt_task_done", 0)
+	, _batches (1024)
 {
 	reset_thread_list ();
 }
@@ -57,7 +66,6 @@ RTTaskList::drop_threads ()
 	}
 	_threads.clear ();
 	_task_run_sem.reset ();
-	_task_end_sem.reset ();
 }
 
 /*static*/ void*
@@ -105,39 +113,48 @@ RTTaskList::reset_thread_list ()
 void
 RTTaskList::run ()
 {
-	Glib::Threads::Mutex::Lock tm (_tasklist_mutex, Glib::Threads::NOT_LOCK);
-	bool wait = true;
+	/* tasks may run plugins, which use the per-thread
+	 * scratch and silent buffers */
+	ProcessThread* pt = new ProcessThread ();
+	pt->get_buffers ();
 
 	while (true) {
-		if (wait) {
-			_task_run_sem.wait ();
+		_task_run_sem.wait ();
+
+		/* every wakeup is matched by exactly one queued batch */
+		Batch* b;
+		if (_batches.pop_front (b)) {
+			run_batch (*b);
 		}
 
 		if (0 == g_atomic_int_get (&_threads_active)) {
-			_task_end_sem.signal ();
 			break;
 		}
+	}
 
-		wait = false;
-
-		boost::function<void ()> to_run;
-		tm.acquire ();
-		if (_tasklist.size () > 0) {
-			to_run = _tasklist.front();
-			_tasklist.pop_front ();
-		}
-		tm.release ();
+	pt->drop_buffers ();
+	delete pt;
+}
 
-		if (!to_run.empty ()) {
-			to_run ();
-			continue;
-		}
+/** Claim and run tasks of @a b until none are left, then drop this
+ *  thread's reference. The caller's reference is dropped last, or the
+ *  last helper wakes it up.
+ */
+void
+RTTaskList::run_batch (Batch& b)
+{
+	TaskList const& tl (*b._tasks);
 
-		if (!wait) {
-			_task_end_sem.signal ();
+	for (;;) {
+		guint const n = g_atomic_int_add (&b._next, 1);
+		if (n >= tl.size ()) {
+			break;
 		}
+		tl[n]();
+	}
 
-		wait = true;
+	if (g_atomic_int_dec_and_test (&b._pending)) {
+		b._done.signal ();
 	}
 }
 
@@ -145,27 +162,52 @@ void
 RTTaskList::process (TaskList const& tl)
 {
 	Glib::Threads::Mutex::Lock pm (_process_mutex);
-	_tasklist = tl;
-	process_tasklist ();
-	_tasklist.clear ();
+	process (tl, _process_batch);
 }
 
 void
-RTTaskList::process_tasklist ()
+RTTaskList::process (TaskList const& tl, Batch& b)
 {
-	if (0 == g_atomic_int_get (&_threads_active) || _threads.size () == 0) {
-		for (TaskList::iterator i = _tasklist.begin (); i != _tasklist.end(); ++i) {
+	if (0 == g_atomic_int_get (&_threads_active) || _threads.size () == 0 || tl.size () < 2) {
+		for (TaskList::const_iterator i = tl.begin (); i != tl.end(); ++i) {
 			(*i)();
 		}
 		return;
 	}
 
-	uint32_t nt = std::min (_threads.size (), _tasklist.size ());
+	b._tasks = &tl;
+	g_atomic_int_set (&b._next, 0);
+	g_atomic_int_set (&b._pending, 1);
 
-	for (uint32_t i = 0; i < nt; ++i) {
+	/* the calling thread handles one share itself */
+	uint32_t const nt = std::min (_threads.size (), tl.size () - 1);
+	uint32_t queued = 0;
+
+	for (; queued < nt; ++queued) {
+		g_atomic_int_inc (&b._pending);
+		if (!_batches.push_back (&b)) {
+			/* many lists in flight, make do with fewer helpers */
+			g_atomic_int_add (&b._pending, -1);
+			break;
+		}
+	}
+
+	for (uint32_t i = 0; i < queued; ++i) {
 		_task_run_sem.signal ();
 	}
-	for (uint32_t i = 0; i < nt; ++i) {
-		_task_end_sem.wait ();
+
+	/* work, then wait until every helper that was woken up for this
+	 * batch is done with it, so that it can be reused right away.
+	 */
+	for (;;) {
+		guint const n = g_atomic_int_add (&b._next, 1);
+		if (n >= tl.size ()) {
+			break;
+		}
+		tl[n]();
+	}
+
+	if (!g_atomic_int_dec_and_test (&b._pending)) {
+		b._done.wait ();
 	}
 }
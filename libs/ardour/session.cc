@@ -240,6 +240,8 @@ Session::Session (AudioEngine &eng,
 	, _state_of_the_state (StateOfTheState(CannotSave|InitialConnecting|Loading))
 	, _suspend_save (0)
 	, _save_queued (false)
+	, _incremental_save (false)
+	, _pending_state_writer (0)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -806,6 +808,9 @@ Session::destroy ()
 	}
 	routes.flush ();
 
+	/* don't build peakfiles for sources that are about to go away */
+	SourceFactory::cancel_peak_work ();
+
 	{
 		DEBUG_TRACE (DEBUG::Destruction, "delete sources\n");
 		Glib::Threads::Mutex::Lock lm (source_lock);
@@ -90,6 +90,7 @@ Session::click (samplepos_t cycle_start, samplecnt_t nframes)
 	start = max (start, (samplepos_t) 0);
 
 	if (end > start) {
+		/* does not take the tempo map lock inside the cycle's read section */
 		_tempo_map->get_grid (points, start, end);
 	}
 
@@ -325,7 +325,7 @@ get_id_sorted_playlists (const List& playlists, IDSortedList& id_sorted_playlist
 } // anonymous namespace
 
 void
-SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unused)
+SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unused, bool incremental)
 {
 	XMLNode* child = node->add_child ("Playlists");
 
@@ -337,7 +337,7 @@ SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unu
 			if (save_template) {
 				child->add_child_nocopy ((*i)->get_template ());
 			} else {
-				child->add_child_nocopy ((*i)->get_state ());
+				child->add_child_nocopy (incremental ? (*i)->cached_state (true) : (*i)->get_state ());
 			}
 		}
 	}
@@ -358,7 +358,7 @@ SessionPlaylists::add_state (XMLNode* node, bool save_template, bool include_unu
 				if (save_template) {
 					child->add_child_nocopy ((*i)->get_template());
 				} else {
-					child->add_child_nocopy ((*i)->get_state());
+					child->add_child_nocopy (incremental ? (*i)->cached_state (true) : (*i)->get_state ());
 				}
 			}
 		}
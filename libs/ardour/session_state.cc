@@ -689,6 +689,12 @@ Session::maybe_write_autosave()
 void
 Session::remove_pending_capture_state ()
 {
+	{
+		/* do not let a queued write bring the file back */
+		Glib::Threads::Mutex::Lock lm (save_state_lock);
+		wait_for_pending_state ();
+	}
+
 	std::string pending_state_file_path(_session_dir->root_path());
 
 	pending_state_file_path = Glib::build_filename (pending_state_file_path, legalize_for_path (_current_snapshot_name) + pending_suffix);
@@ -701,6 +707,55 @@ Session::remove_pending_capture_state ()
 	}
 }
 
+/** @return the path of the binary copy of the state file @a xml_path */
+static string
+binary_state_path (string const& xml_path)
+{
+	string path (xml_path);
+	string const ext (statefile_suffix);
+
+	if (path.length() > ext.length() && 0 == path.compare (path.length() - ext.length(), ext.length(), ext)) {
+		path.erase (path.length() - ext.length());
+	}
+
+	return path + binary_statefile_suffix;
+}
+
+/** @return a checksum of the content of the state file at @a xml_path, or
+ *  an empty string if it cannot be read. A binary state file is only used
+ *  if it carries the same stamp. Size and modification time are not
+ *  enough: an edited or restored file can have both unchanged.
+ */
+static string
+binary_state_stamp (string const& xml_path)
+{
+	string content;
+
+	try {
+		content = Glib::file_get_contents (xml_path);
+	} catch (Glib::FileError const&) {
+		return string ();
+	}
+
+	return Glib::Checksum::compute_checksum (Glib::Checksum::CHECKSUM_SHA1, content);
+}
+
+/** Write @a tree, which was just saved to @a xml_path, in binary form
+ *  alongside it, for faster loading.
+ */
+static void
+save_binary_state (XMLTree const& tree, string const& xml_path)
+{
+	string const stamp (binary_state_stamp (xml_path));
+	string const bin_path (binary_state_path (xml_path));
+
+	if (stamp.empty () || !tree.write_binary (bin_path, stamp)) {
+		/* not fatal, the session will be loaded from XML */
+		warning << string_compose (_("Could not write binary session state to %1"), bin_path) << endmsg;
+		::g_remove (bin_path.c_str());
+	}
+}
+
 /** Rename a state file.
  *  @param old_name Old snapshot name.
  *  @param new_name New snapshot name.
@@ -722,7 +777,11 @@ Session::rename_state (string old_name, string new_name)
 	if (::g_rename (old_xml_path.c_str(), new_xml_path.c_str()) != 0) {
 		error << string_compose(_("could not rename snapshot %1 to %2 (%3)"),
 				old_name, new_name, g_strerror(errno)) << endmsg;
+		return;
 	}
+
+	/* the binary state remains valid, renaming keeps the stamp of the state file */
+	::g_rename (binary_state_path (old_xml_path).c_str(), binary_state_path (new_xml_path).c_str());
 }
 
 /** Remove a state file.
@@ -751,6 +810,8 @@ Session::remove_state (string snapshot_name)
 		error << string_compose(_("Could not remove session file at path \"%1\" (%2)"),
 				xml_path, g_strerror (errno)) << endmsg;
 	}
+
+	::g_remove (binary_state_path (xml_path).c_str());
 }
 
 /** @param snapshot_name Name to save under, without .ardour / .pending prefix */
@@ -770,6 +831,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		lx.acquire ();
 	}
 
+	/* the previous pending state may still be written */
+	wait_for_pending_state ();
+
 	if (!_writable || (_state_of_the_state & CannotSave)) {
 		return 1;
 	}
@@ -801,6 +865,10 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	}
 
 	PBD::Unwinder<bool> uw (LV2Plugin::force_state_save, for_archive);
+	/* pending (crash recovery) state is saved often; reuse the state of
+	 * objects that did not change since it was last saved.
+	 */
+	PBD::Unwinder<bool> uwi (_incremental_save, pending && !template_only);
 
 	SessionSaveUnderway (); /* EMIT SIGNAL */
 
@@ -846,6 +914,55 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
+	if (pending) {
+		/* converting and writing the document can take a while for
+		 * large sessions; do that in the background, the state itself
+		 * has been collected already.
+		 */
+		XMLTree* bg_tree = new XMLTree;
+		bg_tree->set_root (tree.root ());
+		tree.set_root (0);
+
+		try {
+			_pending_state_writer = Glib::Threads::Thread::create (sigc::bind (sigc::mem_fun (*this, &Session::write_pending_state), bg_tree, tmp_path, xml_path));
+		} catch (Glib::Threads::ThreadError const&) {
+			write_pending_state (bg_tree, tmp_path, xml_path);
+		}
+
+	} else if (write_state_file (tree, tmp_path, xml_path)) {
+		return -1;
+
+	} else if (!template_only && !for_archive && Config->get_save_binary_state ()) {
+		save_binary_state (tree, xml_path);
+	}
+
+	if (!pending && !for_archive) {
+
+		save_history (snapshot_name);
+
+		if (mark_as_clean) {
+			bool was_dirty = dirty();
+
+			_state_of_the_state = StateOfTheState (_state_of_the_state & ~Dirty);
+
+			if (was_dirty) {
+				DirtyChanged (); /* EMIT SIGNAL */
+			}
+		}
+
+		StateSaved (snapshot_name); /* EMIT SIGNAL */
+	}
+
+#ifndef NDEBUG
+	const int64_t elapsed_time_us = g_get_monotonic_time() - save_start_time;
+	cerr << "saved state in " << fixed << setprecision (1) << elapsed_time_us / 1000. << " ms\n";
+#endif
+	return 0;
+}
+
+int
+Session::write_state_file (XMLTree& tree, std::string const& tmp_path, std::string const& xml_path)
+{
 #ifndef NDEBUG
 	cerr << "actually writing state to " << tmp_path << endl;
 #endif
@@ -875,28 +992,26 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		}
 	}
 
-	if (!pending && !for_archive) {
-
-		save_history (snapshot_name);
-
-		if (mark_as_clean) {
-			bool was_dirty = dirty();
-
-			_state_of_the_state = StateOfTheState (_state_of_the_state & ~Dirty);
+	return 0;
+}
 
-			if (was_dirty) {
-				DirtyChanged (); /* EMIT SIGNAL */
-			}
-		}
+void
+Session::write_pending_state (XMLTree* tree, std::string tmp_path, std::string xml_path)
+{
+	write_state_file (*tree, tmp_path, xml_path);
+	delete tree;
+}
 
-		StateSaved (snapshot_name); /* EMIT SIGNAL */
+/** Wait for the pending state written by a previous save_state() to be
+ *  on disk. Call with save_state_lock held.
+ */
+void
+Session::wait_for_pending_state ()
+{
+	if (_pending_state_writer) {
+		_pending_state_writer->join ();
+		_pending_state_writer = 0;
 	}
-
-#ifndef NDEBUG
-	const int64_t elapsed_time_us = g_get_monotonic_time() - save_start_time;
-	cerr << "saved state in " << fixed << setprecision (1) << elapsed_time_us / 1000. << " ms\n";
-#endif
-	return 0;
 }
 
 int
@@ -956,7 +1071,18 @@ Session::load_state (string snapshot_name)
 
 	_writable = exists_and_writable (xmlpath) && exists_and_writable(Glib::path_get_dirname(xmlpath));
 
-	if (!state_tree->read (xmlpath)) {
+	/* prefer the binary copy of the state, if it is up to date */
+	bool have_state = false;
+
+	if (!state_was_pending && Config->get_save_binary_state ()) {
+		string const stamp (binary_state_stamp (xmlpath));
+		if (!stamp.empty () && state_tree->read_binary (binary_state_path (xmlpath), stamp)) {
+			state_tree->set_filename (xmlpath);
+			have_state = true;
+		}
+	}
+
+	if (!have_state && !state_tree->read (xmlpath)) {
 		error << string_compose(_("Could not understand session file %1"), xmlpath) << endmsg;
 		delete state_tree;
 		state_tree = 0;
@@ -1440,7 +1566,7 @@ Session::state (bool save_template, snapshot_t snapshot_type, bool only_used_ass
 		}
 	}
 
-	playlists->add_state (node, save_template, !only_used_assets);
+	playlists->add_state (node, save_template, !only_used_assets, _incremental_save);
 
 	child = node->add_child ("RouteGroups");
 	for (list<RouteGroup *>::iterator i = _route_groups.begin(); i != _route_groups.end(); ++i) {
@@ -3597,6 +3723,11 @@ Session::cleanup_sources (CleanupReport& rep)
 			}
 		}
 
+		for (uint32_t l = 0; l < AudioSource::n_peak_levels; ++l) {
+			/* coarser peak levels are always re-computed from the peakfile */
+			::g_unlink (AudioSource::peak_level_path (peakpath, l).c_str ());
+		}
+
 		rep.paths.push_back (*x);
 		rep.space += statbuf.st_size;
 	}
@@ -4845,6 +4976,7 @@ Session::save_as (SaveAs& saveas)
 	vector<string> do_not_copy_extensions;
 	do_not_copy_extensions.push_back (statefile_suffix);
 	do_not_copy_extensions.push_back (pending_suffix);
+	do_not_copy_extensions.push_back (binary_statefile_suffix);
 	do_not_copy_extensions.push_back (backup_suffix);
 	do_not_copy_extensions.push_back (temp_suffix);
 	do_not_copy_extensions.push_back (history_suffix);
@@ -5278,6 +5410,14 @@ Session::archive_session (const std::string& dest,
 	 * don't allow any concurrent saves (periodic or otherwise */
 	Glib::Threads::Mutex::Lock lm (save_source_lock);
 
+	{
+		/* a pending state that is still being written must reach the
+		 * session's own directory before the paths are switched below.
+		 */
+		Glib::Threads::Mutex::Lock ls (save_state_lock);
+		wait_for_pending_state ();
+	}
+
 	disable_record (false);
 
 	/* save current values */
@@ -5349,6 +5489,7 @@ Session::archive_session (const std::string& dest,
 	vector<string> do_not_copy_extensions;
 	do_not_copy_extensions.push_back (statefile_suffix);
 	do_not_copy_extensions.push_back (pending_suffix);
+	do_not_copy_extensions.push_back (binary_statefile_suffix);
 	do_not_copy_extensions.push_back (backup_suffix);
 	do_not_copy_extensions.push_back (temp_suffix);
 	do_not_copy_extensions.push_back (history_suffix);
@@ -29,6 +29,11 @@
 
 #include <sys/stat.h>
 
+#ifdef __linux__
+#include <unistd.h>
+#include <linux/falloc.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 
@@ -36,6 +41,7 @@
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
 
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -52,6 +58,45 @@ using std::string;
 gain_t* SndFileSource::out_coefficient = 0;
 gain_t* SndFileSource::in_coefficient = 0;
 samplecnt_t SndFileSource::xfade_samples = 64;
+
+/** @return the size of one frame of @a info if its samples are stored as plain PCM, 0 otherwise */
+static off_t
+pcm_frame_bytes (SF_INFO const& info)
+{
+	switch (info.format & SF_FORMAT_TYPEMASK) {
+	case SF_FORMAT_WAV:
+	case SF_FORMAT_AIFF:
+	case SF_FORMAT_W64:
+	case SF_FORMAT_RF64:
+	case SF_FORMAT_CAF:
+	case SF_FORMAT_RAW:
+		break;
+	default:
+		return 0;
+	}
+
+	switch (info.format & SF_FORMAT_SUBMASK) {
+	case SF_FORMAT_PCM_S8:
+	case SF_FORMAT_PCM_U8:
+		return info.channels;
+	case SF_FORMAT_PCM_16:
+		return 2 * info.channels;
+	case SF_FORMAT_PCM_24:
+		return 3 * info.channels;
+	case SF_FORMAT_PCM_32:
+	case SF_FORMAT_FLOAT:
+		return 4 * info.channels;
+	case SF_FORMAT_DOUBLE:
+		return 8 * info.channels;
+	default:
+		return 0;
+	}
+}
+
+/* disk space reserved ahead of recording, and data written before waiting for its writeback */
+static const off_t preallocation_bytes = 32 * 1048576;
+static const off_t write_behind_bytes = 1048576;
+
 const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::Writable |
 		Source::Removable |
@@ -339,6 +384,13 @@ SndFileSource::init_sndfile ()
 
 	memset (&_info, 0, sizeof(_info));
 
+	_fd = -1;
+	_data_offset = -1;
+	_frame_bytes = 0;
+	_preallocated = 0;
+	_writeback_start = 0;
+	_writeback_end = 0;
+
 	if (destructive()) {
 		xfade_buf = new Sample[xfade_samples];
 		_timeline_position = header_position_offset;
@@ -351,8 +403,11 @@ void
 SndFileSource::close ()
 {
 	if (_sndfile) {
+		release_preallocation ();
 		sf_close (_sndfile);
 		_sndfile = 0;
+		_fd = -1;
+		_data_offset = -1;
 		file_closed ();
 	}
 }
@@ -406,6 +461,15 @@ SndFileSource::open ()
 		return -1;
 	}
 
+	_fd = fd;
+	_preallocated = 0;
+	_writeback_start = 0;
+	_writeback_end = 0;
+
+	if (!writable()) {
+		locate_sample_data ();
+	}
+
 	if (_channel >= _info.channels) {
 #ifndef HAVE_COREAUDIO
 		error << string_compose(_("SndFileSource: file only contains %1 channels; %2 is invalid as a channel number"), _info.channels, _channel) << endmsg;
@@ -634,6 +698,8 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 
 	update_length (_length + cnt);
 
+	write_behind ();
+
 	if (_build_peakfiles) {
 		compute_and_write_peaks (data, sample_pos, cnt, true, true);
 	}
@@ -779,6 +845,121 @@ SndFileSource::flush ()
 	sf_write_sync (_sndfile);
 }
 
+/** Find the layout of the sample data for prefetch(). Needs an open file
+ * whose header is complete, i.e. one that is no longer written to.
+ */
+void
+SndFileSource::locate_sample_data ()
+{
+	_frame_bytes = pcm_frame_bytes (_info);
+
+	/* seeking to the first frame puts the descriptor at the start of the sample data */
+	if (_frame_bytes != 0 && sf_seek (_sndfile, 0, SEEK_SET) == 0) {
+		_data_offset = ::lseek (_fd, 0, SEEK_CUR);
+	} else {
+		_data_offset = -1;
+	}
+}
+
+void
+SndFileSource::prefetch (samplepos_t start, samplecnt_t cnt)
+{
+#ifdef __linux__
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (writable() || open()) {
+		return;
+	}
+
+	if (_data_offset < 0) {
+		/* opened for writing, and marked immutable since */
+		locate_sample_data ();
+	}
+
+	if (_data_offset < 0 || _frame_bytes == 0 || start >= _length) {
+		return;
+	}
+
+	cnt = min (cnt, _length - start);
+
+	/* starts reading into the page cache, does not wait for it */
+	posix_fadvise (_fd, _data_offset + start * _frame_bytes, cnt * _frame_bytes, POSIX_FADV_WILLNEED);
+#endif
+}
+
+/** Called after appending data to the file. Reserves disk space ahead of
+ * the write position, so that the file system does not allocate blocks
+ * for every write, and starts writeback of the new data while waiting for
+ * (and dropping from the page cache) the data written before. That keeps
+ * dirty pages from piling up during long recordings and the kernel from
+ * flushing them all at once. libsndfile's header is not touched, it is
+ * only updated when the file is closed or flush_header() is called.
+ */
+void
+SndFileSource::write_behind ()
+{
+#ifdef __linux__
+	bool const preallocate = Config->get_preallocate_capture_files ();
+	bool const writeback = Config->get_capture_write_behind ();
+
+	if (_fd < 0 || (!preallocate && !writeback)) {
+		return;
+	}
+
+	off_t const pos = ::lseek (_fd, 0, SEEK_CUR);
+
+	if (pos < 0) {
+		return;
+	}
+
+	if (preallocate && _preallocated >= 0 && pos + preallocation_bytes / 2 > _preallocated) {
+		off_t const start = max (pos, _preallocated);
+		/* keep the file size, libsndfile uses it to locate the end of the data */
+		if (fallocate (_fd, FALLOC_FL_KEEP_SIZE, start, preallocation_bytes) == 0) {
+			_preallocated = start + preallocation_bytes;
+		} else {
+			/* not supported by the file system, do not try again */
+			_preallocated = -1;
+		}
+	}
+
+	if (writeback && pos - _writeback_end >= write_behind_bytes) {
+		sync_file_range (_fd, _writeback_end, pos - _writeback_end, SYNC_FILE_RANGE_WRITE);
+		if (_writeback_end > _writeback_start) {
+			sync_file_range (_fd, _writeback_start, _writeback_end - _writeback_start,
+			                 SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+			posix_fadvise (_fd, _writeback_start, _writeback_end - _writeback_start, POSIX_FADV_DONTNEED);
+		}
+		_writeback_start = _writeback_end;
+		_writeback_end = pos;
+	}
+#endif
+}
+
+/** free disk space reserved beyond the end of the file by write_behind() */
+void
+SndFileSource::release_preallocation ()
+{
+#ifdef __linux__
+	if (_fd < 0 || _preallocated <= 0) {
+		return;
+	}
+
+	off_t const end = ::lseek (_fd, 0, SEEK_END);
+
+	if (end >= 0 && end < _preallocated) {
+		/* truncating to the current size frees blocks beyond it,
+		 * punching a hole there is a no-op on some file systems.
+		 */
+		if (ftruncate (_fd, end)) {
+			warning << string_compose (_("cannot release disk space reserved for %1 (%2)"), _path, strerror (errno)) << endmsg;
+		}
+	}
+
+	_preallocated = 0;
+#endif
+}
+
 int
 SndFileSource::setup_broadcast_info (samplepos_t /*when*/, struct tm& now, time_t /*tnow*/)
 {
@@ -24,6 +24,7 @@
 
 #include "pbd/error.h"
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/pthread_utils.h"
 #include "pbd/stacktrace.h"
 
@@ -32,6 +33,7 @@
 #include "ardour/boost_debug.h"
 #include "ardour/midi_playlist.h"
 #include "ardour/midi_playlist_source.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/source.h"
 #include "ardour/source_factory.h"
 #include "ardour/sndfilesource.h"
@@ -54,8 +56,21 @@ PBD::Signal1<void,boost::shared_ptr<Source> > SourceFactory::SourceCreated;
 Glib::Threads::Cond SourceFactory::PeaksToBuild;
 Glib::Threads::Mutex SourceFactory::peak_building_lock;
 std::list<boost::weak_ptr<AudioSource> > SourceFactory::files_with_peaks;
+std::list<boost::weak_ptr<AudioSource> > SourceFactory::files_with_peak_levels;
 
+/* all protected by peak_building_lock */
 static int active_threads = 0;
+static uint32_t peak_work_done = 0;
+static uint32_t peak_work_total = 0;
+
+/* peak_building_lock MUST be held by caller */
+static void
+queue_peak_levels (boost::shared_ptr<AudioSource> as)
+{
+	SourceFactory::files_with_peak_levels.push_back (boost::weak_ptr<AudioSource> (as));
+	++peak_work_total;
+	SourceFactory::PeaksToBuild.broadcast ();
+}
 
 static void
 peak_thread_work ()
@@ -67,26 +82,43 @@ peak_thread_work ()
 		SourceFactory::peak_building_lock.lock ();
 
 	  wait:
-		if (SourceFactory::files_with_peaks.empty()) {
+		if (SourceFactory::files_with_peaks.empty() && SourceFactory::files_with_peak_levels.empty()) {
+			if (active_threads == 0) {
+				peak_work_done = peak_work_total = 0;
+			}
 			SourceFactory::PeaksToBuild.wait (SourceFactory::peak_building_lock);
 		}
 
-		if (SourceFactory::files_with_peaks.empty()) {
+		if (SourceFactory::files_with_peaks.empty() && SourceFactory::files_with_peak_levels.empty()) {
 			goto wait;
 		}
 
-		boost::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front().lock());
-		SourceFactory::files_with_peaks.pop_front ();
+		/* missing peakfiles first, the levels only speed up zoomed-out views */
+		const bool levels = SourceFactory::files_with_peaks.empty();
+		std::list<boost::weak_ptr<AudioSource> >& queue (levels ? SourceFactory::files_with_peak_levels : SourceFactory::files_with_peaks);
+
+		boost::shared_ptr<AudioSource> as (queue.front().lock());
+		queue.pop_front ();
 		++active_threads;
 		SourceFactory::peak_building_lock.unlock ();
 
-		if (!as) {
-			continue;
+		if (as) {
+			if (levels) {
+				as->build_peak_levels ();
+			} else {
+				as->setup_peakfile ();
+			}
 		}
 
-		as->setup_peakfile ();
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
+		++peak_work_done;
+		if (as && !levels && as->peak_levels_pending ()) {
+			queue_peak_levels (as);
+		}
+		if (SourceFactory::files_with_peaks.empty() && SourceFactory::files_with_peak_levels.empty() && active_threads == 0) {
+			peak_work_done = peak_work_total = 0;
+		}
 		SourceFactory::peak_building_lock.unlock ();
 	}
 }
@@ -96,13 +128,55 @@ SourceFactory::peak_work_queue_length ()
 {
 	// ideally we'd loop over the queue and check for duplicates
 	// and existing valid peak-files..
-	return SourceFactory::files_with_peaks.size () + active_threads;
+	return SourceFactory::files_with_peaks.size () + SourceFactory::files_with_peak_levels.size () + active_threads;
+}
+
+void
+SourceFactory::peak_work_progress (uint32_t& done, uint32_t& total)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+	done = peak_work_done;
+	total = peak_work_total;
+}
+
+void
+SourceFactory::prioritize_peakfile (boost::shared_ptr<Source> s)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+
+	for (std::list<boost::weak_ptr<AudioSource> >::iterator i = files_with_peaks.begin(); i != files_with_peaks.end(); ++i) {
+		if (i->lock() == s) {
+			files_with_peaks.splice (files_with_peaks.begin(), files_with_peaks, i);
+			break;
+		}
+	}
+}
+
+void
+SourceFactory::cancel_peak_work ()
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+	peak_work_total -= files_with_peaks.size () + files_with_peak_levels.size ();
+	files_with_peaks.clear ();
+	files_with_peak_levels.clear ();
+	if (active_threads == 0) {
+		peak_work_done = peak_work_total = 0;
+	}
 }
 
 void
 SourceFactory::init ()
 {
-	for (int n = 0; n < 2; ++n) {
+	/* building peaks is mostly disk bound, beyond a handful of
+	 * concurrent readers additional threads only add seeks.
+	 */
+	uint32_t n_threads = Config->get_peak_building_threads ();
+
+	if (n_threads == 0) {
+		n_threads = max (2U, min (8U, hardware_concurrency ()));
+	}
+
+	for (uint32_t n = 0; n < n_threads; ++n) {
 		Glib::Threads::Thread::create (sigc::ptr_fun (::peak_thread_work));
 	}
 }
@@ -119,6 +193,7 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 
 			Glib::Threads::Mutex::Lock lm (peak_building_lock);
 			files_with_peaks.push_back (boost::weak_ptr<AudioSource> (as));
+			++peak_work_total;
 			PeaksToBuild.broadcast ();
 
 		} else {
@@ -127,6 +202,11 @@ SourceFactory::setup_peakfile (boost::shared_ptr<Source> s, bool async)
 				error << string_compose("SourceFactory: could not set up peakfile for %1", as->name()) << endmsg;
 				return -1;
 			}
+
+			if (as->peak_levels_pending ()) {
+				Glib::Threads::Mutex::Lock lm (peak_building_lock);
+				queue_peak_levels (as);
+			}
 		}
 	}
 
@@ -117,3 +117,79 @@ x86_sse_avx_find_peaks(const float* buf, uint32_t nframes, float *min, float *ma
 }
 
 
+/* fused region read kernels, see AudioRegion::read_at().
+ * The gain curve and the buffers are not necessarily aligned.
+ */
+
+void
+x86_sse_avx_mix_buffers_with_gain_curve (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m256 vscale = _mm256_set1_ps (scale);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_mul_ps (_mm256_loadu_ps (gain), vscale);
+		__m256 d = _mm256_add_ps (_mm256_loadu_ps (dst), _mm256_mul_ps (_mm256_loadu_ps (src), g));
+		_mm256_storeu_ps (dst, d);
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * (*gain++ * scale);
+		--nframes;
+	}
+
+	// zero upper 128 bit of 256 bit ymm register to avoid penalties using non-AVX instructions
+	_mm256_zeroupper ();
+}
+
+void
+x86_sse_avx_copy_vector_with_gain_curve (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m256 vscale = _mm256_set1_ps (scale);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_mul_ps (_mm256_loadu_ps (gain), vscale);
+		_mm256_storeu_ps (dst, _mm256_mul_ps (_mm256_loadu_ps (src), g));
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ = *src++ * (*gain++ * scale);
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+}
+
+void
+x86_sse_avx_crossfade_buffers (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m256 vscale = _mm256_set1_ps (scale);
+	const __m256 one    = _mm256_set1_ps (1.f);
+
+	while (nframes >= 8) {
+		__m256 g = _mm256_loadu_ps (gain);
+		__m256 d = _mm256_mul_ps (_mm256_loadu_ps (dst), _mm256_sub_ps (one, g));
+		d = _mm256_add_ps (d, _mm256_mul_ps (_mm256_loadu_ps (src), _mm256_mul_ps (g, vscale)));
+		_mm256_storeu_ps (dst, d);
+		dst += 8;
+		src += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst = *dst * (1.f - *gain) + *src++ * (*gain * scale);
+		++dst;
+		++gain;
+		--nframes;
+	}
+
+	_mm256_zeroupper ();
+}
@@ -54,3 +54,23 @@ x86_sse_avx_find_peaks (const float * buf, uint32_t nsamples, float *min, float
 {
 	default_find_peaks (buf, nsamples, min, max);
 }
+
+/* there is no AVX variant of the gain-curve functions, use SSE (sse_functions_xmm.cc) */
+
+void
+x86_sse_avx_mix_buffers_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes)
+{
+	x86_sse_mix_buffers_with_gain_curve (dst, src, gain, scale, nframes);
+}
+
+void
+x86_sse_avx_copy_vector_with_gain_curve (float * dst, const float * src, const float * gain, float scale, uint32_t nframes)
+{
+	x86_sse_copy_vector_with_gain_curve (dst, src, gain, scale, nframes);
+}
+
+void
+x86_sse_avx_crossfade_buffers (float * dst, const float * src, const float * gain, float scale, uint32_t nframes)
+{
+	x86_sse_crossfade_buffers (dst, src, gain, scale, nframes);
+}
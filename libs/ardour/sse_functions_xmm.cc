@@ -117,3 +117,73 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 
 
 
+
+/* fused region read kernels, see AudioRegion::read_at().
+ * The gain curve and the buffers are not necessarily aligned.
+ */
+
+void
+x86_sse_mix_buffers_with_gain_curve (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m128 vscale = _mm_set1_ps (scale);
+
+	while (nframes >= 4) {
+		__m128 g = _mm_mul_ps (_mm_loadu_ps (gain), vscale);
+		__m128 d = _mm_add_ps (_mm_loadu_ps (dst), _mm_mul_ps (_mm_loadu_ps (src), g));
+		_mm_storeu_ps (dst, d);
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*dst++ += *src++ * (*gain++ * scale);
+		--nframes;
+	}
+}
+
+void
+x86_sse_copy_vector_with_gain_curve (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m128 vscale = _mm_set1_ps (scale);
+
+	while (nframes >= 4) {
+		__m128 g = _mm_mul_ps (_mm_loadu_ps (gain), vscale);
+		_mm_storeu_ps (dst, _mm_mul_ps (_mm_loadu_ps (src), g));
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*dst++ = *src++ * (*gain++ * scale);
+		--nframes;
+	}
+}
+
+void
+x86_sse_crossfade_buffers (float* dst, const float* src, const float* gain, float scale, uint32_t nframes)
+{
+	const __m128 vscale = _mm_set1_ps (scale);
+	const __m128 one    = _mm_set1_ps (1.f);
+
+	while (nframes >= 4) {
+		__m128 g = _mm_loadu_ps (gain);
+		__m128 d = _mm_mul_ps (_mm_loadu_ps (dst), _mm_sub_ps (one, g));
+		d = _mm_add_ps (d, _mm_mul_ps (_mm_loadu_ps (src), _mm_mul_ps (g, vscale)));
+		_mm_storeu_ps (dst, d);
+		dst += 4;
+		src += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	while (nframes > 0) {
+		*dst = *dst * (1.f - *gain) + *src++ * (*gain * scale);
+		++dst;
+		++gain;
+		--nframes;
+	}
+}
@@ -716,6 +716,8 @@ struct MetricSectionFrameSorter {
 };
 
 TempoMap::TempoMap (samplecnt_t fr)
+	: _snapshot (new Snapshot)
+	, _snapshot_stale (1)
 {
 	_sample_rate = fr;
 	BBT_Time start (1, 1, 0);
@@ -733,6 +735,7 @@ TempoMap::TempoMap (samplecnt_t fr)
 	_metrics.push_back (t);
 	_metrics.push_back (m);
 
+	publish_snapshot ();
 }
 
 TempoMap&
@@ -762,8 +765,11 @@ TempoMap::operator= (TempoMap const & other)
 				_metrics.push_back (new_section);
 			}
 		}
+
+		mark_snapshot_stale ();
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange());
 
 	return *this;
@@ -806,6 +812,7 @@ TempoMap::remove_tempo (const TempoSection& tempo, bool complete_operation)
 	}
 
 	if (removed && complete_operation) {
+		publish_snapshot ();
 		PropertyChanged (PropertyChange ());
 	}
 }
@@ -845,6 +852,7 @@ TempoMap::remove_meter (const MeterSection& tempo, bool complete_operation)
 	}
 
 	if (removed && complete_operation) {
+		publish_snapshot ();
 		PropertyChanged (PropertyChange ());
 	}
 }
@@ -1036,6 +1044,7 @@ TempoMap::add_tempo (const Tempo& tempo, const double& pulse, const samplepos_t
 		recompute_map (_metrics);
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 
 	return ts;
@@ -1087,6 +1096,7 @@ TempoMap::replace_tempo (TempoSection& ts, const Tempo& tempo, const double& pul
 		recompute_map (_metrics);
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 }
 
@@ -1114,6 +1124,7 @@ TempoMap::add_tempo_locked (const Tempo& tempo, double pulse, double minute
 		}
 	}
 
+	/* callers that solve the map here must mark_snapshot_stale () */
 	if (recompute) {
 		if (pls == AudioTime) {
 			solve_map_minute (_metrics, t, t->minute());
@@ -1133,6 +1144,8 @@ TempoMap::add_meter (const Meter& meter, const Timecode::BBT_Time& where, sample
 	{
 		Glib::Threads::RWLock::WriterLock lm (lock);
 		m = add_meter_locked (meter, where, sample, pls, true);
+		/* an audio-locked meter is solved without recompute_map () */
+		mark_snapshot_stale ();
 	}
 
 
@@ -1142,6 +1155,7 @@ TempoMap::add_meter (const Meter& meter, const Timecode::BBT_Time& where, sample
 	}
 #endif
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 	return m;
 }
@@ -1155,6 +1169,7 @@ TempoMap::replace_meter (const MeterSection& ms, const Meter& meter, const BBT_T
 		if (!ms.initial()) {
 			remove_meter_locked (ms);
 			add_meter_locked (meter, where, sample, pls, true);
+			mark_snapshot_stale ();
 		} else {
 			MeterSection& first (first_meter());
 			TempoSection& first_t (first_tempo());
@@ -1173,6 +1188,7 @@ TempoMap::replace_meter (const MeterSection& ms, const Meter& meter, const BBT_T
 		}
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 }
 
@@ -1249,6 +1265,7 @@ TempoMap::change_initial_tempo (double note_types_per_minute, double note_type,
 				*((Tempo*) t) = newtempo;
 				recompute_map (_metrics);
 			}
+			publish_snapshot ();
 			PropertyChanged (PropertyChange ());
 			break;
 		}
@@ -1304,6 +1321,7 @@ TempoMap::change_existing_tempo_at (samplepos_t where, double note_types_per_min
 		recompute_map (_metrics);
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 }
 
@@ -1522,6 +1540,128 @@ TempoMap::recompute_map (Metrics& metrics, samplepos_t end)
 
 	recompute_tempi (metrics);
 	recompute_meters (metrics);
+
+	if (&metrics == &_metrics) {
+		mark_snapshot_stale ();
+	}
+}
+
+/** Note that _metrics was solved, and must be published by publish_snapshot().
+ * CALLER MUST HOLD WRITE LOCK.
+ */
+void
+TempoMap::mark_snapshot_stale ()
+{
+	g_atomic_int_set (&_snapshot_stale, 1);
+}
+
+/** Publish a copy of the current map for lookups that must not take the lock,
+ * if it was solved since the last call.
+ * CALLER MUST NOT HOLD THE LOCK: edits call this once they released it.
+ */
+void
+TempoMap::publish_snapshot ()
+{
+	if (!g_atomic_int_compare_and_exchange (&_snapshot_stale, 1, 0)) {
+		return;
+	}
+
+	RCUWriter<Snapshot> writer (_snapshot);
+	boost::shared_ptr<Snapshot> snapshot = writer.get_copy ();
+
+	Glib::Threads::RWLock::ReaderLock lm (lock);
+	snapshot->set (_metrics);
+}
+
+/** @return the current snapshot. Inside an RCUEpoch::ReadSection (the process
+ * cycle) this does not touch any reference count, otherwise @a keep holds a
+ * reference for as long as the snapshot is used.
+ */
+const TempoMap::Snapshot*
+TempoMap::read_snapshot (boost::shared_ptr<Snapshot>& keep) const
+{
+	if (RCUEpoch::in_read_section ()) {
+		return _snapshot.rt_reader ();
+	}
+
+	keep = _snapshot.reader ();
+	return keep.get ();
+}
+
+void
+TempoMap::Snapshot::set (const Metrics& m)
+{
+	sections.clear ();
+	metrics.clear ();
+	tempi.clear ();
+	tempo_minutes.clear ();
+	tempo_pulses.clear ();
+
+	for (Metrics::const_iterator i = m.begin(); i != m.end(); ++i) {
+		MetricSection* section;
+
+		if ((*i)->is_tempo()) {
+			TempoSection* t = new TempoSection (*static_cast<TempoSection*> (*i));
+			if (t->active()) {
+				tempi.push_back (t);
+				tempo_minutes.push_back (t->minute());
+				tempo_pulses.push_back (t->pulse());
+			}
+			section = t;
+		} else {
+			section = new MeterSection (*static_cast<MeterSection*> (*i));
+		}
+
+		sections.push_back (boost::shared_ptr<MetricSection> (section));
+		metrics.push_back (section);
+	}
+}
+
+/* binary search equivalent of TempoMap::pulse_at_minute_locked() */
+double
+TempoMap::Snapshot::pulse_at_minute (const double& minute) const
+{
+	assert (!tempi.empty());
+
+	/* the first active section, after the first, which starts later than minute */
+	const size_t n = tempi.size();
+	const size_t next = upper_bound (tempo_minutes.begin() + 1, tempo_minutes.end(), minute) - tempo_minutes.begin();
+
+	if (next < n) {
+		/*the previous ts is the one containing the sample */
+		const double ret = tempi[next - 1]->pulse_at_minute (minute);
+		/* audio locked section in new meter*/
+		if (tempi[next]->pulse() < ret) {
+			return tempi[next]->pulse();
+		}
+		return ret;
+	}
+
+	/* treated as constant for this ts */
+	const TempoSection* prev_t = tempi[n - 1];
+	const double pulses_in_section = ((minute - prev_t->minute()) * prev_t->note_types_per_minute()) / prev_t->note_type();
+
+	return pulses_in_section + prev_t->pulse();
+}
+
+/* binary search equivalent of TempoMap::minute_at_pulse_locked() */
+double
+TempoMap::Snapshot::minute_at_pulse (const double& pulse) const
+{
+	assert (!tempi.empty());
+
+	const size_t n = tempi.size();
+	const size_t next = upper_bound (tempo_pulses.begin() + 1, tempo_pulses.end(), pulse) - tempo_pulses.begin();
+
+	if (next < n) {
+		return tempi[next - 1]->minute_at_pulse (pulse);
+	}
+
+	/* must be treated as constant, irrespective of _type */
+	const TempoSection* prev_t = tempi[n - 1];
+	double const dtime = ((pulse - prev_t->pulse()) * prev_t->note_type()) / prev_t->note_types_per_minute();
+
+	return dtime + prev_t->minute();
 }
 
 TempoMetric
@@ -2102,13 +2242,10 @@ TempoMap::quarter_note_at_bbt (const Timecode::BBT_Time& bbt)
 double
 TempoMap::quarter_note_at_bbt_rt (const Timecode::BBT_Time& bbt)
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
-
-	if (!lm.locked()) {
-		throw std::logic_error ("TempoMap::quarter_note_at_bbt_rt() could not lock tempo map");
-	}
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
 
-	return pulse_at_bbt_locked (_metrics, bbt) * 4.0;
+	return pulse_at_bbt_locked (snapshot->metrics, bbt) * 4.0;
 }
 
 double
@@ -2252,13 +2389,10 @@ TempoMap::bbt_at_sample_rt (samplepos_t sample)
 {
 	const double minute =  minute_at_sample (sample);
 
-	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
 
-	if (!lm.locked()) {
-		throw std::logic_error ("TempoMap::bbt_at_sample_rt() could not lock tempo map");
-	}
-
-	return bbt_at_minute_locked (_metrics, minute);
+	return bbt_at_minute_locked (snapshot->metrics, minute);
 }
 
 Timecode::BBT_Time
@@ -2380,24 +2514,18 @@ double
 TempoMap::quarter_note_at_sample (const samplepos_t sample) const
 {
 	const double minute =  minute_at_sample (sample);
+	boost::shared_ptr<Snapshot> keep;
 
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-
-	return pulse_at_minute_locked (_metrics, minute) * 4.0;
+	return read_snapshot (keep)->pulse_at_minute (minute) * 4.0;
 }
 
 double
 TempoMap::quarter_note_at_sample_rt (const samplepos_t sample) const
 {
 	const double minute =  minute_at_sample (sample);
+	boost::shared_ptr<Snapshot> keep;
 
-	Glib::Threads::RWLock::ReaderLock lm (lock, Glib::Threads::TRY_LOCK);
-
-	if (!lm.locked()) {
-		throw std::logic_error ("TempoMap::quarter_note_at_sample_rt() could not lock tempo map");
-	}
-
-	return pulse_at_minute_locked (_metrics, minute) * 4.0;
+	return read_snapshot (keep)->pulse_at_minute (minute) * 4.0;
 }
 
 /**
@@ -2411,12 +2539,8 @@ TempoMap::quarter_note_at_sample_rt (const samplepos_t sample) const
 samplepos_t
 TempoMap::sample_at_quarter_note (const double quarter_note) const
 {
-	double minute;
-	{
-		Glib::Threads::RWLock::ReaderLock lm (lock);
-
-		minute = minute_at_pulse_locked (_metrics, quarter_note / 4.0);
-	}
+	boost::shared_ptr<Snapshot> keep;
+	const double minute = read_snapshot (keep)->minute_at_pulse (quarter_note / 4.0);
 
 	return sample_at_minute (minute);
 }
@@ -2464,12 +2588,9 @@ TempoMap::beat_at_quarter_note (const double quarter_note) const
 samplecnt_t
 TempoMap::samples_between_quarter_notes (const double start, const double end) const
 {
-	double minutes;
-
-	{
-		Glib::Threads::RWLock::ReaderLock lm (lock);
-		minutes = minutes_between_quarter_notes_locked (_metrics, start, end);
-	}
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
+	const double minutes = snapshot->minute_at_pulse (end / 4.0) - snapshot->minute_at_pulse (start / 4.0);
 
 	return sample_at_minute (minutes);
 }
@@ -2484,9 +2605,10 @@ TempoMap::minutes_between_quarter_notes_locked (const Metrics& metrics, const do
 double
 TempoMap::quarter_notes_between_samples (const samplecnt_t start, const samplecnt_t end) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
 
-	return quarter_notes_between_samples_locked (_metrics, start, end);
+	return quarter_notes_between_samples_locked (snapshot->metrics, start, end);
 }
 
 double
@@ -3198,6 +3320,7 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const samplepos_t sample, co
 				if (solve_map_pulse (future_map, tempo_copy, pulse)) {
 					solve_map_pulse (_metrics, ts, pulse);
 					recompute_meters (_metrics);
+					mark_snapshot_stale ();
 				}
 			}
 		}
@@ -3223,11 +3346,13 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const samplepos_t sample, co
 					solve_map_pulse (_metrics, ts, qn / 4.0);
 					ts->set_position_lock_style (AudioTime);
 					recompute_meters (_metrics);
+					mark_snapshot_stale ();
 				}
 			} else {
 				if (solve_map_minute (future_map, tempo_copy, minute_at_sample (sample))) {
 					solve_map_minute (_metrics, ts, minute_at_sample (sample));
 					recompute_meters (_metrics);
+					mark_snapshot_stale ();
 				}
 			}
 		}
@@ -3239,6 +3364,7 @@ TempoMap::gui_set_tempo_position (TempoSection* ts, const samplepos_t sample, co
 		++d;
 	}
 
+	publish_snapshot ();
 	MetricPositionChanged (PropertyChange ()); // Emit Signal
 }
 
@@ -3264,6 +3390,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const samplepos_t sample)
 			if (solve_map_minute (future_map, copy, minute_at_sample (sample))) {
 				solve_map_minute (_metrics, ms, minute_at_sample (sample));
 				recompute_tempi (_metrics);
+				mark_snapshot_stale ();
 			}
 		}
 	} else {
@@ -3277,6 +3404,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const samplepos_t sample)
 			if (solve_map_bbt (future_map, copy, bbt)) {
 				solve_map_bbt (_metrics, ms, bbt);
 				recompute_tempi (_metrics);
+				mark_snapshot_stale ();
 			}
 		}
 	}
@@ -3287,6 +3415,7 @@ TempoMap::gui_set_meter_position (MeterSection* ms, const samplepos_t sample)
 		++d;
 	}
 
+	publish_snapshot ();
 	MetricPositionChanged (PropertyChange ()); // Emit Signal
 }
 
@@ -3343,6 +3472,7 @@ TempoMap::gui_change_tempo (TempoSection* ts, const Tempo& bpm)
 		++d;
 	}
 	if (can_solve) {
+		publish_snapshot ();
 		MetricPositionChanged (PropertyChange ()); // Emit Signal
 	}
 
@@ -3441,6 +3571,7 @@ TempoMap::gui_stretch_tempo (TempoSection* ts, const samplepos_t sample, const s
 
 			recompute_tempi (_metrics);
 			recompute_meters (_metrics);
+			mark_snapshot_stale ();
 		}
 	}
 
@@ -3451,6 +3582,7 @@ out:
 		delete (*d);
 		++d;
 	}
+	publish_snapshot ();
 	MetricPositionChanged (PropertyChange ()); // Emit Signal
 
 
@@ -3522,6 +3654,7 @@ TempoMap::gui_stretch_tempo_end (TempoSection* ts, const samplepos_t sample, con
 
 			recompute_tempi (_metrics);
 			recompute_meters (_metrics);
+			mark_snapshot_stale ();
 		}
 	}
 
@@ -3533,6 +3666,7 @@ out:
 		++d;
 	}
 
+	publish_snapshot ();
 	MetricPositionChanged (PropertyChange ()); // Emit Signal
 }
 
@@ -3726,6 +3860,7 @@ TempoMap::gui_twist_tempi (TempoSection* ts, const Tempo& bpm, const samplepos_t
 		++d;
 	}
 
+	publish_snapshot ();
 	MetricPositionChanged (PropertyChange ()); // Emit Signal
 
 	return can_solve;
@@ -3801,9 +3936,10 @@ TempoMap::exact_beat_at_sample_locked (const Metrics& metrics, const samplepos_t
 double
 TempoMap::exact_qn_at_sample (const samplepos_t sample, const int32_t sub_num) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
 
-	return exact_qn_at_sample_locked (_metrics, sample, sub_num);
+	return exact_qn_at_sample_locked (snapshot->metrics, sample, sub_num);
 }
 
 double
@@ -4108,29 +4244,34 @@ void
 TempoMap::get_grid (vector<TempoMap::BBTPoint>& points,
 		    samplepos_t lower, samplepos_t upper, uint32_t bar_mod)
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-	int32_t cnt = ceil (beat_at_minute_locked (_metrics, minute_at_sample (lower)));
+	/* called by Session::click() in the process thread: use the snapshot,
+	 * which does not wait for the lock there.
+	 */
+	boost::shared_ptr<Snapshot> keep;
+	const Metrics& metrics (read_snapshot (keep)->metrics);
+
+	int32_t cnt = ceil (beat_at_minute_locked (metrics, minute_at_sample (lower)));
 	samplecnt_t pos = 0;
 	/* although the map handles negative beats, bbt doesn't. */
 	if (cnt < 0.0) {
 		cnt = 0.0;
 	}
 
-	if (minute_at_beat_locked (_metrics, cnt) >= minute_at_sample (upper)) {
+	if (minute_at_beat_locked (metrics, cnt) >= minute_at_sample (upper)) {
 		return;
 	}
 	if (bar_mod == 0) {
 		while (pos >= 0 && pos < upper) {
-			pos = sample_at_minute (minute_at_beat_locked (_metrics, cnt));
-			const MeterSection meter = meter_section_at_minute_locked (_metrics, minute_at_sample (pos));
-			const BBT_Time bbt = bbt_at_beat_locked (_metrics, cnt);
-			const double qn = pulse_at_beat_locked (_metrics, cnt) * 4.0;
+			pos = sample_at_minute (minute_at_beat_locked (metrics, cnt));
+			const MeterSection meter = meter_section_at_minute_locked (metrics, minute_at_sample (pos));
+			const BBT_Time bbt = bbt_at_beat_locked (metrics, cnt);
+			const double qn = pulse_at_beat_locked (metrics, cnt) * 4.0;
 
-			points.push_back (BBTPoint (meter, tempo_at_minute_locked (_metrics, minute_at_sample (pos)), pos, bbt.bars, bbt.beats, qn));
+			points.push_back (BBTPoint (meter, tempo_at_minute_locked (metrics, minute_at_sample (pos)), pos, bbt.bars, bbt.beats, qn));
 			++cnt;
 		}
 	} else {
-		BBT_Time bbt = bbt_at_minute_locked (_metrics, minute_at_sample (lower));
+		BBT_Time bbt = bbt_at_minute_locked (metrics, minute_at_sample (lower));
 		bbt.beats = 1;
 		bbt.ticks = 0;
 
@@ -4140,11 +4281,11 @@ TempoMap::get_grid (vector<TempoMap::BBTPoint>& points,
 		}
 
 		while (pos >= 0 && pos < upper) {
-			pos = sample_at_minute (minute_at_bbt_locked (_metrics, bbt));
-			const MeterSection meter = meter_section_at_minute_locked (_metrics, minute_at_sample (pos));
-			const double qn = pulse_at_bbt_locked (_metrics, bbt) * 4.0;
+			pos = sample_at_minute (minute_at_bbt_locked (metrics, bbt));
+			const MeterSection meter = meter_section_at_minute_locked (metrics, minute_at_sample (pos));
+			const double qn = pulse_at_bbt_locked (metrics, bbt) * 4.0;
 
-			points.push_back (BBTPoint (meter, tempo_at_minute_locked (_metrics, minute_at_sample (pos)), pos, bbt.bars, bbt.beats, qn));
+			points.push_back (BBTPoint (meter, tempo_at_minute_locked (metrics, minute_at_sample (pos)), pos, bbt.bars, bbt.beats, qn));
 			bbt.bars += bar_mod;
 		}
 	}
@@ -4666,6 +4807,7 @@ TempoMap::set_state (const XMLNode& node, int /*version*/)
 		old_metrics.clear ();
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 
 	return 0;
@@ -4755,6 +4897,7 @@ TempoMap::insert_time (samplepos_t where, samplecnt_t amount)
 		}
 	}
 
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 }
 
@@ -4815,6 +4958,7 @@ TempoMap::remove_time (samplepos_t where, samplecnt_t amount)
 			recompute_map (_metrics);
 		}
 	}
+	publish_snapshot ();
 	PropertyChanged (PropertyChange ());
 	return moved;
 }
@@ -4825,10 +4969,11 @@ TempoMap::remove_time (samplepos_t where, samplecnt_t amount)
 samplepos_t
 TempoMap::samplepos_plus_qn (samplepos_t sample, Temporal::Beats beats) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
-	const double sample_qn = pulse_at_minute_locked (_metrics, minute_at_sample (sample)) * 4.0;
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
+	const double sample_qn = snapshot->pulse_at_minute (minute_at_sample (sample)) * 4.0;
 
-	return sample_at_minute (minute_at_pulse_locked (_metrics, (sample_qn + beats.to_double()) / 4.0));
+	return sample_at_minute (snapshot->minute_at_pulse ((sample_qn + beats.to_double()) / 4.0));
 }
 
 samplepos_t
@@ -4861,9 +5006,10 @@ TempoMap::samplepos_plus_bbt (samplepos_t pos, BBT_Time op) const
 Temporal::Beats
 TempoMap::framewalk_to_qn (samplepos_t pos, samplecnt_t distance) const
 {
-	Glib::Threads::RWLock::ReaderLock lm (lock);
+	boost::shared_ptr<Snapshot> keep;
+	const Snapshot* snapshot = read_snapshot (keep);
 
-	return Temporal::Beats (quarter_notes_between_samples_locked (_metrics, pos, pos + distance));
+	return Temporal::Beats (quarter_notes_between_samples_locked (snapshot->metrics, pos, pos + distance));
 }
 
 struct bbtcmp {
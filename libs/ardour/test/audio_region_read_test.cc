@@ -16,6 +16,9 @@
     Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 */
 
+#include <vector>
+
+#include "ardour/automation_list.h"
 #include "ardour/playlist.h"
 #include "ardour/region.h"
 #include "ardour/audioregion.h"
@@ -91,3 +94,114 @@ AudioRegionReadTest::check_staircase (Sample* b, int offset, int N)
 		CPPUNIT_ASSERT_EQUAL (j, int (b[i]));
 	}
 }
+
+void
+AudioRegionReadTest::setup_gain_and_fades ()
+{
+	_ar[0]->set_position (0);
+	_ar[0]->set_length (1024);
+	_ar[0]->set_fade_in (FadeConstantPower, 100);
+	_ar[0]->set_fade_out (FadeLinear, 200);
+	_ar[0]->set_fade_in_active (true);
+	_ar[0]->set_fade_out_active (true);
+
+	_ar[0]->envelope()->clear ();
+	_ar[0]->envelope()->fast_simple_add (0, 0.5);
+	_ar[0]->envelope()->fast_simple_add (1024, 1.5);
+	_ar[0]->set_envelope_active (true);
+	_ar[0]->set_scale_amplitude (0.7);
+}
+
+/** Compare a read against the envelope, scale, fades and mix applied one pass at a time */
+void
+AudioRegionReadTest::check_fused_read (samplepos_t pos, samplecnt_t cnt)
+{
+	boost::shared_ptr<AudioRegion> ar = _ar[0];
+	samplecnt_t const length = ar->length ();
+	float const lower = 1000;
+
+	std::vector<Sample> buf (cnt, lower);
+	std::vector<Sample> mbuf (cnt);
+	std::vector<float> gbuf (cnt);
+
+	CPPUNIT_ASSERT_EQUAL (cnt, ar->read_at (&buf[0], &mbuf[0], &gbuf[0], pos, cnt, 0));
+
+	/* reference */
+	std::vector<Sample> ref (cnt, lower);
+	std::vector<Sample> mix (cnt);
+	std::vector<float> gain (cnt);
+
+	CPPUNIT_ASSERT_EQUAL (cnt, ar->read_from_sources (ar->_sources, length, &mix[0], pos, cnt, 0));
+
+	if (ar->envelope_active ()) {
+		ar->_envelope->curve().get_vector (pos, pos + cnt, &gain[0], cnt);
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			mix[n] *= gain[n];
+		}
+	}
+	for (samplecnt_t n = 0; n < cnt; ++n) {
+		mix[n] *= ar->scale_amplitude ();
+	}
+
+	samplecnt_t fade_in_limit = 0;
+	samplecnt_t const fade_in_length = (samplecnt_t) ar->_fade_in->back()->when;
+	if (pos < fade_in_length) {
+		fade_in_limit = std::min (cnt, fade_in_length - pos);
+		ar->_inverse_fade_in->curve().get_vector (pos, pos + fade_in_limit, &gain[0], fade_in_limit);
+		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
+			ref[n] *= gain[n];
+		}
+		ar->_fade_in->curve().get_vector (pos, pos + fade_in_limit, &gain[0], fade_in_limit);
+		for (samplecnt_t n = 0; n < fade_in_limit; ++n) {
+			ref[n] += mix[n] * gain[n];
+		}
+	}
+
+	samplecnt_t fade_out_limit = 0;
+	samplepos_t const fade_start = std::max (pos, length - (samplecnt_t) ar->_fade_out->back()->when);
+	if (pos + cnt > fade_start) {
+		fade_out_limit = pos + cnt - fade_start;
+		samplecnt_t const offset = fade_start - pos;
+		samplecnt_t const curve_offset = fade_start - (length - ar->_fade_out->back()->when);
+		ar->_inverse_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, &gain[0], fade_out_limit);
+		for (samplecnt_t n = 0; n < fade_out_limit; ++n) {
+			ref[offset + n] *= gain[n];
+		}
+		ar->_fade_out->curve().get_vector (curve_offset, curve_offset + fade_out_limit, &gain[0], fade_out_limit);
+		for (samplecnt_t n = 0; n < fade_out_limit; ++n) {
+			ref[offset + n] += mix[offset + n] * gain[n];
+		}
+	}
+
+	for (samplecnt_t n = fade_in_limit; n < cnt - fade_out_limit; ++n) {
+		ref[n] = mix[n];
+	}
+
+	for (samplecnt_t n = 0; n < cnt; ++n) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (ref[n], buf[n], 1e-2);
+	}
+}
+
+void
+AudioRegionReadTest::fusedReadTest ()
+{
+	setup_gain_and_fades ();
+
+	/* whole region, one read */
+	check_fused_read (0, 1024);
+	/* starting in the fade in, ending in the body */
+	check_fused_read (50, 300);
+	/* body only */
+	check_fused_read (200, 400);
+	/* body and part of the fade out */
+	check_fused_read (700, 324);
+	/* small, unaligned blocks */
+	for (samplepos_t p = 0; p < 1024; p += 37) {
+		check_fused_read (p, std::min ((samplecnt_t) 37, (samplecnt_t) 1024 - p));
+	}
+
+	/* without envelope */
+	_ar[0]->set_envelope_active (false);
+	check_fused_read (0, 1024);
+	check_fused_read (50, 300);
+}
@@ -23,11 +23,15 @@ class AudioRegionReadTest : public AudioRegionTest
 {
 	CPPUNIT_TEST_SUITE (AudioRegionReadTest);
 	CPPUNIT_TEST (readTest);
+	CPPUNIT_TEST (fusedReadTest);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
 	void readTest ();
+	void fusedReadTest ();
 
 private:
 	void check_staircase (ARDOUR::Sample *, int, int);
+	void setup_gain_and_fades ();
+	void check_fused_read (ARDOUR::samplepos_t, ARDOUR::samplecnt_t);
 };
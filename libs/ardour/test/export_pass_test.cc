@@ -0,0 +1,110 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "ardour/export_handler.h"
+#include "ardour/export_timespan.h"
+#include "export_pass_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ExportPassTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+ExportTimespanPtr
+ExportPassTest::timespan (samplepos_t start, samplepos_t end)
+{
+	ExportElementFactory factory (*_session);
+	ExportTimespanPtr t = factory.add_timespan ();
+	t->set_range (start, end);
+	return t;
+}
+
+void
+ExportPassTest::overlapTest ()
+{
+	ExportTimespanPtr first = timespan (1000, 5000);
+	ExportTimespanPtr inside = timespan (2000, 3000);
+	ExportTimespanPtr across = timespan (4000, 9000);
+	ExportTimespanPtr chained = timespan (8000, 12000);
+
+	vector<ExportTimespanPtr> candidates;
+	candidates.push_back (first);
+	candidates.push_back (inside);
+	candidates.push_back (across);
+	candidates.push_back (chained);
+
+	vector<ExportTimespanPtr> group = ExportHandler::pass_group (first, candidates, 0);
+
+	/* the pass itself is not part of the group, the others are in start order */
+	CPPUNIT_ASSERT_EQUAL (size_t (3), group.size ());
+	CPPUNIT_ASSERT (group[0] == inside);
+	CPPUNIT_ASSERT (group[1] == across);
+	/* only reachable because "across" extends the pass */
+	CPPUNIT_ASSERT (group[2] == chained);
+}
+
+void
+ExportPassTest::outOfOrderTest ()
+{
+	ExportTimespanPtr first = timespan (10000, 20000);
+	ExportTimespanPtr before = timespan (0, 5000);
+	ExportTimespanPtr overlapping_start = timespan (5000, 15000);
+	ExportTimespanPtr late = timespan (30000, 40000);
+	ExportTimespanPtr bridge = timespan (18000, 32000);
+
+	/* candidates come in config_map order, which is not the time order */
+	vector<ExportTimespanPtr> candidates;
+	candidates.push_back (late);
+	candidates.push_back (before);
+	candidates.push_back (bridge);
+	candidates.push_back (overlapping_start);
+
+	vector<ExportTimespanPtr> group = ExportHandler::pass_group (first, candidates, 0);
+
+	/* nothing starting before the pass may join it, even if it overlaps.
+	 * "late" joins once "bridge" has extended the pass, although
+	 * it was looked at first.
+	 */
+	CPPUNIT_ASSERT_EQUAL (size_t (2), group.size ());
+	CPPUNIT_ASSERT (group[0] == bridge);
+	CPPUNIT_ASSERT (group[1] == late);
+}
+
+void
+ExportPassTest::gapTest ()
+{
+	ExportTimespanPtr first = timespan (0, 1000);
+	ExportTimespanPtr close_by = timespan (1500, 2000);
+	ExportTimespanPtr distant = timespan (5000, 6000);
+
+	vector<ExportTimespanPtr> candidates;
+	candidates.push_back (distant);
+	candidates.push_back (close_by);
+
+	vector<ExportTimespanPtr> group = ExportHandler::pass_group (first, candidates, 0);
+	CPPUNIT_ASSERT (group.empty ());
+
+	group = ExportHandler::pass_group (first, candidates, 500);
+	CPPUNIT_ASSERT_EQUAL (size_t (1), group.size ());
+	CPPUNIT_ASSERT (group[0] == close_by);
+
+	group = ExportHandler::pass_group (first, candidates, 3000);
+	CPPUNIT_ASSERT_EQUAL (size_t (2), group.size ());
+	CPPUNIT_ASSERT (group[0] == close_by);
+	CPPUNIT_ASSERT (group[1] == distant);
+}
@@ -0,0 +1,42 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "ardour/export_pointers.h"
+#include "ardour/types.h"
+
+#include "test_needing_session.h"
+
+class ExportPassTest : public TestNeedingSession
+{
+	CPPUNIT_TEST_SUITE (ExportPassTest);
+	CPPUNIT_TEST (overlapTest);
+	CPPUNIT_TEST (outOfOrderTest);
+	CPPUNIT_TEST (gapTest);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void overlapTest ();
+	void outOfOrderTest ();
+	void gapTest ();
+
+private:
+	ARDOUR::ExportTimespanPtr timespan (ARDOUR::samplepos_t start, ARDOUR::samplepos_t end);
+};
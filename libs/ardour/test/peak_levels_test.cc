@@ -0,0 +1,119 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <glibmm/miscutils.h>
+
+#include "ardour/audiosource.h"
+#include "ardour/sndfilesource.h"
+#include "ardour/source_factory.h"
+#include "peak_levels_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PeakLevelsTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/* samples per peak of the main peakfile, _FPP in audiosource.cc */
+static const size_t base_fpp = 256;
+
+static vector<PeakData>
+read_peakfile (string const& path)
+{
+	ifstream f (path.c_str (), ios::binary | ios::ate);
+	CPPUNIT_ASSERT (f.good ());
+
+	vector<PeakData> peaks (f.tellg () / sizeof (PeakData));
+	f.seekg (0);
+	f.read ((char*) &peaks[0], peaks.size () * sizeof (PeakData));
+
+	return peaks;
+}
+
+/** every peak of a level must be the min/max of the main peaks it covers */
+void
+PeakLevelsTest::check_levels (boost::shared_ptr<AudioSource> s)
+{
+	vector<PeakData> const base = read_peakfile (s->_peakpath);
+	CPPUNIT_ASSERT (!base.empty ());
+
+	for (uint32_t l = 0; l < AudioSource::n_peak_levels; ++l) {
+		CPPUNIT_ASSERT (s->_peak_levels[l].built);
+
+		vector<PeakData> const level = read_peakfile (s->_peak_levels[l].path);
+		size_t const ratio = s->_peak_levels[l].fpp / base_fpp;
+
+		CPPUNIT_ASSERT_EQUAL ((base.size () + ratio - 1) / ratio, level.size ());
+
+		for (size_t i = 0; i < level.size (); ++i) {
+			PeakData expected = base[i * ratio];
+			for (size_t j = i * ratio + 1; j < min ((i + 1) * ratio, base.size ()); ++j) {
+				expected.min = min (expected.min, base[j].min);
+				expected.max = max (expected.max, base[j].max);
+			}
+			CPPUNIT_ASSERT_EQUAL (expected.min, level[i].min);
+			CPPUNIT_ASSERT_EQUAL (expected.max, level[i].max);
+		}
+	}
+}
+
+void
+PeakLevelsTest::levelsTest ()
+{
+	string const path = Glib::build_filename (new_test_output_dir (), "levels.wav");
+
+	AudioSource::set_build_peakfiles (false);
+	boost::shared_ptr<SndFileSource> s = boost::dynamic_pointer_cast<SndFileSource> (
+		SourceFactory::createWritable (DataType::AUDIO, *_session, path, false, get_test_sample_rate ()));
+	CPPUNIT_ASSERT (s);
+
+	/* a few peaks of the coarsest level and a partial one, with an
+	 * amplitude that changes every 1000 samples.
+	 */
+	samplecnt_t const n = base_fpp * 16 * 16 * 5 + 1234;
+	vector<Sample> signal (n);
+	for (samplecnt_t i = 0; i < n; ++i) {
+		signal[i] = sinf (i * 0.01f) * ((i / 1000) % 17) / 17.f;
+	}
+	CPPUNIT_ASSERT_EQUAL (n, s->write (&signal[0], n));
+
+	/* no peakfile yet: the main peakfile and the levels are built together */
+	AudioSource::set_build_peakfiles (true);
+	AudioSource::set_build_missing_peakfiles (true);
+	s->close_peakfile ();
+	CPPUNIT_ASSERT_EQUAL (0, s->setup_peakfile ());
+	check_levels (s);
+
+	/* levels missing for an existing peakfile: built from the peakfile,
+	 * by the peak threads.
+	 */
+	s->remove_peak_levels ();
+	s->close_peakfile ();
+	CPPUNIT_ASSERT_EQUAL (0, s->setup_peakfile ());
+	CPPUNIT_ASSERT (s->peak_levels_pending ());
+	CPPUNIT_ASSERT_EQUAL (0, s->build_peak_levels ());
+	CPPUNIT_ASSERT (!s->peak_levels_pending ());
+	check_levels (s);
+
+	AudioSource::set_build_peakfiles (false);
+	AudioSource::set_build_missing_peakfiles (false);
+}
@@ -0,0 +1,136 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_factory.h"
+#include "playlist_region_index_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistRegionIndexTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** Put enough overlapping copies of our regions on _playlist that
+ *  range queries go via the playlist's region index.
+ */
+void
+PlaylistRegionIndexTest::add_many_regions ()
+{
+	for (int i = 0; i < 256; ++i) {
+		boost::shared_ptr<Region> r = RegionFactory::create (_r[i % 16], false);
+		/* regions are 100 samples long; vary the spacing so that some overlap and some leave gaps */
+		_playlist->add_region (r, (i * 37) + ((i % 5) * 60));
+	}
+}
+
+/** Compare the indexed queries against a linear scan of the region list */
+void
+PlaylistRegionIndexTest::check_queries ()
+{
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	for (samplepos_t p = -10; p < 256 * 37 + 400; p += 7) {
+
+		samplepos_t const end = p + (p % 150);
+
+		uint32_t at = 0;
+		uint32_t touched = 0;
+
+		for (RegionList::const_iterator i = all->begin(); i != all->end(); ++i) {
+			if ((*i)->covers (p)) {
+				++at;
+			}
+			if ((*i)->coverage (p, end) != Evoral::OverlapNone) {
+				++touched;
+			}
+		}
+
+		CPPUNIT_ASSERT_EQUAL (at, _playlist->count_regions_at (p));
+		CPPUNIT_ASSERT_EQUAL (at > 0, _playlist->has_region_at (p));
+		CPPUNIT_ASSERT_EQUAL (size_t (at), _playlist->regions_at (p)->size ());
+		CPPUNIT_ASSERT_EQUAL (size_t (touched), _playlist->regions_touched (p, end)->size ());
+	}
+}
+
+void
+PlaylistRegionIndexTest::queryTest ()
+{
+	add_many_regions ();
+	check_queries ();
+}
+
+/* Check that the index follows regions which are moved, trimmed and removed */
+void
+PlaylistRegionIndexTest::moveTest ()
+{
+	add_many_regions ();
+	check_queries ();
+
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	int n = 0;
+	for (RegionList::const_iterator i = all->begin(); i != all->end(); ++i, ++n) {
+		if (n % 3 == 0) {
+			(*i)->set_position ((*i)->position () + 500);
+		} else if (n % 3 == 1) {
+			(*i)->set_length (40, 0);
+		}
+	}
+
+	check_queries ();
+
+	n = 0;
+	for (RegionList::const_iterator i = all->begin(); i != all->end(); ++i, ++n) {
+		if (n % 2) {
+			_playlist->remove_region (*i);
+		}
+	}
+
+	check_queries ();
+}
+
+/* Check that the index follows regions which are moved while their
+ * property changes are suspended, and again once they are thawed.
+ */
+void
+PlaylistRegionIndexTest::frozenMoveTest ()
+{
+	add_many_regions ();
+	check_queries ();
+
+	boost::shared_ptr<RegionList> all = _playlist->region_list ();
+
+	int n = 0;
+	for (RegionList::const_iterator i = all->begin(); i != all->end(); ++i, ++n) {
+		(*i)->suspend_property_changes ();
+		if (n % 2) {
+			(*i)->set_position ((*i)->position () + 700);
+		} else {
+			(*i)->set_length (30, 0);
+		}
+	}
+
+	check_queries ();
+
+	for (RegionList::const_iterator i = all->begin(); i != all->end(); ++i) {
+		(*i)->resume_property_changes ();
+	}
+
+	check_queries ();
+}
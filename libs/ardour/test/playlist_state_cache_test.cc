@@ -0,0 +1,91 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include "pbd/xml++.h"
+#include "ardour/playlist.h"
+#include "ardour/region.h"
+#include "ardour/region_factory.h"
+#include "playlist_state_cache_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (PlaylistStateCacheTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** The state used by incremental saves must always match the real one */
+void
+PlaylistStateCacheTest::check_cached_state ()
+{
+	XMLNode& cached = _playlist->cached_state (true);
+	XMLNode& fresh = _playlist->get_state ();
+
+	CPPUNIT_ASSERT (cached == fresh);
+
+	delete &cached;
+	delete &fresh;
+}
+
+void
+PlaylistStateCacheTest::cacheTest ()
+{
+	for (int i = 0; i < 16; ++i) {
+		_playlist->add_region (RegionFactory::create (_r[i], false), i * 200);
+	}
+	check_cached_state ();
+
+	/* unchanged: the cached copy is reused */
+	check_cached_state ();
+
+	boost::shared_ptr<RegionList> rl = _playlist->region_list ();
+
+	rl->front()->set_position (5000);
+	check_cached_state ();
+
+	rl->back()->set_name ("renamed");
+	check_cached_state ();
+
+	rl->back()->set_muted (true);
+	check_cached_state ();
+
+	_playlist->remove_region (rl->front ());
+	check_cached_state ();
+
+	_playlist->set_name ("another name");
+	check_cached_state ();
+
+	XMLNode* extra = new XMLNode (X_("UI"));
+	extra->set_property (X_("height"), 42);
+	_playlist->add_extra_xml (*extra);
+	check_cached_state ();
+
+	/* changes made while the region's property changes are suspended */
+	rl->back()->suspend_property_changes ();
+	rl->back()->set_name ("renamed again");
+	check_cached_state ();
+	rl->back()->resume_property_changes ();
+	check_cached_state ();
+
+	/* region extra XML, added and then modified without notice */
+	extra = new XMLNode (X_("GUI"));
+	extra->set_property (X_("color"), 7);
+	rl->back()->add_extra_xml (*extra);
+	check_cached_state ();
+
+	rl->back()->extra_xml (X_("GUI"))->set_property (X_("color"), 8);
+	check_cached_state ();
+}
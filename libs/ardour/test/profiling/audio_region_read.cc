@@ -0,0 +1,79 @@
+#include <iostream>
+#include <vector>
+#include <glibmm/miscutils.h>
+#include "pbd/timing.h"
+#include "evoral/ControlList.hpp"
+#include "ardour/ardour.h"
+#include "ardour/audioregion.h"
+#include "ardour/automation_list.h"
+#include "ardour/region_factory.h"
+#include "ardour/session.h"
+#include "ardour/sndfilesource.h"
+#include "ardour/source_factory.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/** Time AudioRegion::read_at() with envelope, scale amplitude and fades */
+int
+main (int argc, char* argv[])
+{
+	ARDOUR::init (false, true, localedir);
+	create_and_start_dummy_backend ();
+
+	Session* session = load_session (Glib::build_filename (new_test_output_dir (), "audio_region_read"), "audio_region_read");
+
+	int const N = 1024;
+	int const n_reads = 20000;
+
+	{
+		boost::shared_ptr<Source> source = SourceFactory::createWritable (DataType::AUDIO, *session,
+		                                                                  Glib::build_filename (new_test_output_dir (), "read.wav"),
+		                                                                  false, get_test_sample_rate ());
+		boost::shared_ptr<SndFileSource> s = boost::dynamic_pointer_cast<SndFileSource> (source);
+		assert (s);
+
+		std::vector<Sample> staircase (N);
+		for (int i = 0; i < N; ++i) {
+			staircase[i] = i / (float) N;
+		}
+		s->write (&staircase[0], N);
+
+		PropertyList plist;
+		plist.add (Properties::start, 0);
+		plist.add (Properties::length, N);
+		boost::shared_ptr<AudioRegion> ar = boost::dynamic_pointer_cast<AudioRegion> (RegionFactory::create (source, plist));
+		assert (ar);
+
+		ar->set_fade_in (FadeConstantPower, 100);
+		ar->set_fade_out (FadeLinear, 200);
+		ar->set_fade_in_active (true);
+		ar->set_fade_out_active (true);
+		ar->envelope()->clear ();
+		ar->envelope()->fast_simple_add (0, 0.5);
+		ar->envelope()->fast_simple_add (N, 1.5);
+		ar->set_envelope_active (true);
+		ar->set_scale_amplitude (0.7);
+
+		std::vector<Sample> buf (N);
+		std::vector<Sample> mbuf (N);
+		std::vector<float> gbuf (N);
+
+		PBD::Timing timing;
+		for (int i = 0; i < n_reads; ++i) {
+			ar->read_at (&buf[0], &mbuf[0], &gbuf[0], 0, N, 0);
+		}
+		timing.update ();
+
+		cout << "AudioRegion::read_at: " << n_reads << " reads of " << N << " samples with envelope, scale and fades in "
+		     << timing.elapsed_msecs () << " ms\n";
+	}
+
+	delete session;
+	stop_and_destroy_backend ();
+	return 0;
+}
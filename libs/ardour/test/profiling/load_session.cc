@@ -1,16 +1,35 @@
 #include "test_util.h"
 #include "pbd/failed_constructor.h"
+#include "pbd/timing.h"
+#include "pbd/xml++.h"
 #include "ardour/ardour.h"
 #include "ardour/audioengine.h"
+#include "ardour/filename_extensions.h"
 #include "ardour/session.h"
+#include <glibmm/miscutils.h>
 #include <iostream>
 #include <cstdlib>
+#ifndef PLATFORM_WINDOWS
+#include <sys/resource.h>
+#endif
 
 using namespace std;
 using namespace ARDOUR;
 
 static const char* localedir = LOCALEDIR;
 
+static long
+peak_rss_kb ()
+{
+#ifndef PLATFORM_WINDOWS
+	struct rusage ru;
+	if (getrusage (RUSAGE_SELF, &ru) == 0) {
+		return ru.ru_maxrss;
+	}
+#endif
+	return -1;
+}
+
 int main (int argc, char* argv[])
 {
 	if (argc != 3) {
@@ -20,10 +39,25 @@ int main (int argc, char* argv[])
 
 	ARDOUR::init (false, true, localedir);
 
+	/* the XML alone, as read by Session::load_state() */
+	PBD::Timing timing;
+	{
+		XMLTree tree;
+		timing.start ();
+		if (!tree.read (Glib::build_filename (argv[1], string (argv[2]) + statefile_suffix))) {
+			cerr << "cannot parse session file\n";
+			exit (EXIT_FAILURE);
+		}
+		timing.update ();
+	}
+	cout << "XML parse: " << timing.elapsed () / 1000 << " ms, peak RSS " << peak_rss_kb () << " kB\n";
+
 	Session* s = 0;
 
 	try {
+		timing.start ();
 		s = load_session (argv[1], argv[2]);
+		timing.update ();
 	} catch (failed_constructor& e) {
 		cerr << "failed_constructor: " << e.what() << "\n";
 		exit (EXIT_FAILURE);
@@ -38,6 +72,8 @@ int main (int argc, char* argv[])
 		exit (EXIT_FAILURE);
 	}
 
+	cout << "Session load: " << timing.elapsed () / 1000 << " ms, peak RSS " << peak_rss_kb () << " kB\n";
+
 	AudioEngine::instance()->remove_session ();
 	delete s;
 	AudioEngine::instance()->stop ();
@@ -1,3 +1,4 @@
+#include <iostream>
 #include "test_util.h"
 #include "ardour/ardour.h"
 #include "ardour/midi_track.h"
@@ -5,6 +6,7 @@
 #include "ardour/session.h"
 #include "ardour/playlist.h"
 #include "pbd/stateful_diff_command.h"
+#include "pbd/timing.h"
 
 using namespace std;
 using namespace ARDOUR;
@@ -48,4 +50,35 @@ main (int argc, char* argv[])
 	playlist->duplicate (region, region->last_sample() + 1, 1000);
 	session->add_command (new StatefulDiffCommand (playlist));
 	session->commit_reversible_command ();
+
+	/* Now time range queries on the resulting playlist */
+	samplepos_t const extent = playlist->get_extent().second;
+	int const n_queries = 100000;
+	size_t found = 0;
+
+	PBD::Timing timing;
+
+	timing.start ();
+	for (int i = 0; i < n_queries; ++i) {
+		samplepos_t const p = extent / n_queries * i;
+		found += playlist->regions_touched (p, p + 1024)->size ();
+	}
+	timing.update ();
+	cout << "regions_touched: " << n_queries << " queries on " << playlist->n_regions () << " regions, "
+	     << found << " hits in " << timing.elapsed_msecs () << " ms\n";
+
+	found = 0;
+	timing.start ();
+	for (int i = 0; i < n_queries; ++i) {
+		found += playlist->count_regions_at (extent / n_queries * i);
+	}
+	timing.update ();
+	cout << "count_regions_at: " << n_queries << " queries, " << found << " hits in " << timing.elapsed_msecs () << " ms\n";
+
+	timing.start ();
+	for (int i = 0; i < n_queries; ++i) {
+		playlist->find_next_top_layer_position (extent / n_queries * i);
+	}
+	timing.update ();
+	cout << "find_next_top_layer_position: " << n_queries << " queries in " << timing.elapsed_msecs () << " ms\n";
 }
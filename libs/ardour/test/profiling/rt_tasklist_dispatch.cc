@@ -0,0 +1,72 @@
+#include <iostream>
+#include <vector>
+#include <boost/bind.hpp>
+#include "pbd/timing.h"
+#include "ardour/ardour.h"
+#include "ardour/rt_tasklist.h"
+#include "ardour/utils.h"
+#include "test_util.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace PBD;
+
+static const char* localedir = LOCALEDIR;
+
+/* a small amount of work per task, similar to applying gain to a port buffer */
+static void
+apply_gain (float* buf, uint32_t nframes)
+{
+	for (uint32_t i = 0; i < nframes; ++i) {
+		buf[i] *= 0.999f;
+	}
+}
+
+int
+main (int argc, char* argv[])
+{
+	ARDOUR::init (false, true, localedir);
+	create_and_start_dummy_backend ();
+
+	RTTaskList tasklist;
+
+	int const n_tasks = 64;
+	int const n_cycles = 20000;
+	uint32_t const sizes[] = { 32, 64, 128 };
+
+	cout << "INFO: " << how_many_dsp_threads () << " DSP threads, " << n_tasks << " tasks per cycle, " << n_cycles << " cycles\n";
+
+	for (size_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s) {
+		uint32_t const nframes = sizes[s];
+		vector<vector<float> > buffers (n_tasks, vector<float> (nframes, 1.f));
+
+		RTTaskList::TaskList tl;
+		for (int t = 0; t < n_tasks; ++t) {
+			tl.push_back (boost::bind (&apply_gain, &buffers[t][0], nframes));
+		}
+
+		/* reference: run all tasks in this thread */
+		PBD::Timing timing;
+		for (int c = 0; c < n_cycles; ++c) {
+			for (RTTaskList::TaskList::const_iterator i = tl.begin (); i != tl.end (); ++i) {
+				(*i)();
+			}
+		}
+		timing.update ();
+		double const serial = timing.elapsed ();
+
+		timing.start ();
+		for (int c = 0; c < n_cycles; ++c) {
+			tasklist.process (tl);
+		}
+		timing.update ();
+		double const parallel = timing.elapsed ();
+
+		cout << nframes << " samples: serial " << serial / n_cycles << " us/cycle, "
+		     << "tasklist " << parallel / n_cycles << " us/cycle, "
+		     << "dispatch overhead " << 1000. * (parallel - serial / how_many_dsp_threads ()) / (n_cycles * n_tasks) << " ns/task\n";
+	}
+
+	stop_and_destroy_backend ();
+	return 0;
+}
@@ -0,0 +1,95 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <glibmm/miscutils.h>
+
+#include "ardour/audiofilesource.h"
+#include "ardour/read_batch.h"
+#include "ardour/source_factory.h"
+#include "read_batch_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ReadBatchTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+static boost::shared_ptr<AudioFileSource>
+create_source (Session& session, string const& name)
+{
+	boost::shared_ptr<AudioFileSource> s = boost::dynamic_pointer_cast<AudioFileSource> (
+		SourceFactory::createWritable (DataType::AUDIO, session, Glib::build_filename (new_test_output_dir (), name), false, get_test_sample_rate ()));
+	CPPUNIT_ASSERT (s);
+	return s;
+}
+
+void
+ReadBatchTest::coalesceTest ()
+{
+	boost::shared_ptr<AudioFileSource> a = create_source (*_session, "a.wav");
+	boost::shared_ptr<AudioFileSource> b = create_source (*_session, "b.wav");
+
+	ReadBatch batch;
+
+	/* in no particular order, as tracks would add them */
+	batch.add (b, 0, 10);
+	batch.add (a, 500, 10);
+	batch.add (a, 100, 50);
+	batch.add (a, 0, 100);   // adjacent to 100..150
+	batch.add (a, 120, 100); // overlaps 100..150
+	batch.add (a, 130, 10);  // contained in 120..220
+	batch.add (b, 5, 0);     // empty, ignored
+	batch.add (boost::shared_ptr<AudioFileSource> (), 0, 10);
+
+	CPPUNIT_ASSERT_EQUAL (size_t (6), batch.size ());
+
+	batch.coalesce ();
+
+	CPPUNIT_ASSERT_EQUAL (size_t (3), batch._requests.size ());
+
+	/* sorted by file, then by position */
+	CPPUNIT_ASSERT (batch._requests[0].source == a);
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (0), batch._requests[0].start);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (220), batch._requests[0].cnt);
+
+	CPPUNIT_ASSERT (batch._requests[1].source == a);
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (500), batch._requests[1].start);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (10), batch._requests[1].cnt);
+
+	CPPUNIT_ASSERT (batch._requests[2].source == b);
+	CPPUNIT_ASSERT_EQUAL (samplepos_t (0), batch._requests[2].start);
+	CPPUNIT_ASSERT_EQUAL (samplecnt_t (10), batch._requests[2].cnt);
+}
+
+void
+ReadBatchTest::submitTest ()
+{
+	boost::shared_ptr<AudioFileSource> a = create_source (*_session, "c.wav");
+
+	ReadBatch batch;
+
+	/* submitting an empty batch does nothing */
+	batch.submit ();
+
+	batch.add (a, 0, 100);
+	batch.add (a, 50, 100);
+
+	/* the source is still writable, prefetch() ignores it */
+	batch.submit ();
+	CPPUNIT_ASSERT_EQUAL (size_t (0), batch.size ());
+}
@@ -331,6 +331,7 @@ TempoTest::qnDistanceTestRamp ()
 	Meter meterB (3, 4);
 	map.add_meter (meterB, BBT_Time (2, 1, 0), 288e3, AudioTime);
 	map.recompute_map (map._metrics, 1);
+	map.publish_snapshot ();
 
 	list<MetricSection*>::iterator i = map._metrics.begin();
 	CPPUNIT_ASSERT_EQUAL (samplepos_t (0), (*i)->sample ());
@@ -635,3 +636,98 @@ TempoTest::tempoFundamentalsTest ()
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (164.0, tE->quarter_notes_per_minute (), 1e-17);
 	CPPUNIT_ASSERT_DOUBLES_EQUAL (41.0, tE->pulses_per_minute (), 1e-17);
 }
+
+/* check that the lock-free lookups agree with the list-walking ones */
+void
+TempoTest::snapshotTest ()
+{
+	int const sampling_rate = 48000;
+
+	TempoMap map (sampling_rate);
+	Meter meterA (4, 4);
+	Meter meterB (3, 4);
+	Tempo tempoA (77.0, 4.0, 217.0);
+	Tempo tempoB (217.0, 4.0, 120.0);
+	Tempo tempoC (120.0, 4.0);
+	map.replace_tempo (map.first_tempo(), tempoA, 0.0, 0, AudioTime);
+	map.add_tempo (tempoB, 0.0, (samplepos_t) 60 * sampling_rate, AudioTime);
+	map.add_tempo (tempoC, 0.0, (samplepos_t) 90 * sampling_rate, AudioTime);
+	map.replace_meter (map.first_meter(), meterA, BBT_Time (1, 1, 0), 0, AudioTime);
+	map.add_meter (meterB, BBT_Time (40, 1, 0), 0, MusicTime);
+
+	for (samplepos_t s = 0; s < (samplepos_t) 120 * sampling_rate; s += 4321) {
+		const double minute = map.minute_at_sample (s);
+		const double qn = map.pulse_at_minute_locked (map._metrics, minute) * 4.0;
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (qn, map.quarter_note_at_sample (s), 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (qn, map.quarter_note_at_sample_rt (s), 1e-9);
+		CPPUNIT_ASSERT_EQUAL (map.sample_at_minute (map.minute_at_pulse_locked (map._metrics, qn / 4.0)), map.sample_at_quarter_note (qn));
+		CPPUNIT_ASSERT (map.bbt_at_minute_locked (map._metrics, minute) == map.bbt_at_sample_rt (s));
+	}
+
+	{
+		/* the process cycle: lookups use the snapshot without reference counting */
+		RCUEpoch::ReadSection rs;
+
+		for (samplepos_t s = 0; s < (samplepos_t) 120 * sampling_rate; s += 4321) {
+			const double minute = map.minute_at_sample (s);
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (map.pulse_at_minute_locked (map._metrics, minute) * 4.0, map.quarter_note_at_sample_rt (s), 1e-9);
+			CPPUNIT_ASSERT (map.bbt_at_minute_locked (map._metrics, minute) == map.bbt_at_sample_rt (s));
+		}
+
+		std::vector<TempoMap::BBTPoint> points;
+		map.get_grid (points, 0, (samplepos_t) 120 * sampling_rate);
+		CPPUNIT_ASSERT (!points.empty ());
+
+		for (std::vector<TempoMap::BBTPoint>::const_iterator p = points.begin(); p != points.end(); ++p) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (map.pulse_at_bbt_locked (map._metrics, p->bbt ()) * 4.0, p->qn, 1e-9);
+		}
+	}
+
+	/* edits are visible to the lock-free lookups once they are complete */
+	map.remove_tempo (map.tempo_section_at_sample ((samplepos_t) 90 * sampling_rate), true);
+	const samplepos_t s = (samplepos_t) 100 * sampling_rate;
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (map.pulse_at_minute_locked (map._metrics, map.minute_at_sample (s)) * 4.0, map.quarter_note_at_sample (s), 1e-9);
+}
+
+/* audio-locked meters are solved without recompute_map (), the lock-free
+ * lookups must see them nonetheless.
+ */
+void
+TempoTest::audioLockedSnapshotTest ()
+{
+	int const sampling_rate = 48000;
+
+	TempoMap map (sampling_rate);
+	Meter meterA (4, 4);
+	Meter meterB (3, 4);
+	Meter meterC (7, 8);
+	Tempo tempoA (120.0, 4.0);
+	Tempo tempoB (60.0, 4.0);
+	map.replace_tempo (map.first_tempo(), tempoA, 0.0, 0, AudioTime);
+	map.replace_meter (map.first_meter(), meterA, BBT_Time (1, 1, 0), 0, AudioTime);
+	map.add_tempo (tempoB, 0.0, (samplepos_t) 30 * sampling_rate, AudioTime);
+
+	/* not at the natural time of bar 20, which moves its meter-locked tempo */
+	MeterSection* ms = map.add_meter (meterB, BBT_Time (20, 1, 0), (samplepos_t) 50 * sampling_rate, AudioTime);
+	CPPUNIT_ASSERT (ms);
+
+	for (samplepos_t s = 0; s < (samplepos_t) 90 * sampling_rate; s += 4321) {
+		const double minute = map.minute_at_sample (s);
+		const double qn = map.pulse_at_minute_locked (map._metrics, minute) * 4.0;
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (qn, map.quarter_note_at_sample (s), 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (map.exact_qn_at_sample_locked (map._metrics, s, 0), map.exact_qn_at_sample (s, 0), 1e-9);
+		CPPUNIT_ASSERT (map.bbt_at_minute_locked (map._metrics, minute) == map.bbt_at_sample_rt (s));
+	}
+
+	/* likewise when replacing it */
+	map.replace_meter (*ms, meterC, BBT_Time (20, 1, 0), (samplepos_t) 52 * sampling_rate, AudioTime);
+
+	for (samplepos_t s = 0; s < (samplepos_t) 90 * sampling_rate; s += 4321) {
+		const double minute = map.minute_at_sample (s);
+
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (map.pulse_at_minute_locked (map._metrics, minute) * 4.0, map.quarter_note_at_sample (s), 1e-9);
+		CPPUNIT_ASSERT (map.bbt_at_minute_locked (map._metrics, minute) == map.bbt_at_sample_rt (s));
+	}
+}
@@ -481,6 +481,18 @@ Track::do_refill ()
 	return _disk_reader->do_refill ();
 }
 
+int
+Track::do_refill (Sample* mixdown_buffer, gain_t* gain_buffer)
+{
+	return _disk_reader->do_refill (mixdown_buffer, gain_buffer);
+}
+
+void
+Track::add_read_requests (ReadBatch& batch) const
+{
+	_disk_reader->add_read_requests (batch);
+}
+
 int
 Track::do_flush (RunContext c, bool force)
 {
@@ -65,7 +65,9 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		outputs.erase (new_end, outputs.end());
 	}
 
-	/// Processes context concurrently by scheduling each output separately to the given thread pool
+	/** Processes context concurrently by scheduling each output separately to the given thread pool.
+	  * The calling thread processes the first output itself, rather than idling until the pool is done.
+	  */
 	void process (ProcessContext<T> const & c)
 	{
 		wait_mutex.lock();
@@ -74,10 +76,15 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 
 		unsigned int outs = outputs.size();
 		g_atomic_int_add (&readers, outs);
-		for (unsigned int i = 0; i < outs; ++i) {
+		for (unsigned int i = 1; i < outs; ++i) {
 			thread_pool.push (sigc::bind (sigc::mem_fun (this, &Threader::process_output), c, i));
 		}
 
+		if (outs > 0) {
+			run_output (c, 0);
+			g_atomic_int_add (&readers, -1);
+		}
+
 		wait();
 	}
 
@@ -99,7 +106,7 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		}
 	}
 
-	void process_output(ProcessContext<T> const & c, unsigned int output)
+	void run_output(ProcessContext<T> const & c, unsigned int output)
 	{
 		try {
 			outputs[output]->process (c);
@@ -109,8 +116,17 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 			if(!exception) { exception.reset (new ThreaderException (*this, e)); }
 			exception_mutex.unlock();
 		}
+	}
+
+	void process_output(ProcessContext<T> const & c, unsigned int output)
+	{
+		run_output (c, output);
 
 		if (g_atomic_int_dec_and_test (&readers)) {
+			/* wait() checks readers with the mutex held, so the
+			 * wakeup can not get lost (and cost a wait_timeout).
+			 */
+			Glib::Threads::Mutex::Lock lm (wait_mutex);
 			wait_cond.signal();
 		}
 	}
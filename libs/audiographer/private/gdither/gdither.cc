@@ -313,6 +313,50 @@ inline static void gdither_innner_loop_fp(const GDitherType dt,
     }
 }
 
+/* inner loop for undithered integer output of all channels at once.
+ * Clamping before rounding gives the same result as the other way
+ * around (the limits are integers) and keeps the loop free of branches,
+ * rintf() rounds like lrintf() but unlike it can be vectorised
+ */
+inline static void gdither_none_loop(const float bias, const float scale,
+    const int32_t post_scale, const int bit_depth, const uint32_t length,
+    float const *x, void *y, const float clamp_u, const float clamp_l)
+{
+    uint32_t i;
+    uint8_t *o8 = (uint8_t*) y;
+    int16_t *o16 = (int16_t*) y;
+    int32_t *o32 = (int32_t*) y;
+    float tmp;
+
+    switch (bit_depth) {
+    case GDither8bit:
+	for (i = 0; i < length; i++) {
+	    tmp = x[i] * scale + bias;
+	    tmp = tmp > clamp_l ? tmp : clamp_l;
+	    tmp = tmp < clamp_u ? tmp : clamp_u;
+	    o8[i] = (uint8_t) ((int32_t) rintf(tmp) * post_scale);
+	}
+	break;
+    case GDither16bit:
+	for (i = 0; i < length; i++) {
+	    tmp = x[i] * scale + bias;
+	    tmp = tmp > clamp_l ? tmp : clamp_l;
+	    tmp = tmp < clamp_u ? tmp : clamp_u;
+	    o16[i] = (int16_t) ((int32_t) rintf(tmp) * post_scale);
+	}
+	break;
+    case GDither32bit:
+    case GDitherPerformanceTest:
+	for (i = 0; i < length; i++) {
+	    tmp = x[i] * scale + bias;
+	    tmp = tmp > clamp_l ? tmp : clamp_l;
+	    tmp = tmp < clamp_u ? tmp : clamp_u;
+	    o32[i] = (int32_t) rintf(tmp) * post_scale;
+	}
+	break;
+    }
+}
+
 #define GDITHER_CONV_BLOCK 512
 
 void gdither_run(GDither s, uint32_t channel, uint32_t length,
@@ -474,4 +518,39 @@ void gdither_runf(GDither s, uint32_t channel, uint32_t length,
     }
 }
 
+void gdither_runf_interleaved(GDither s, uint32_t length,
+                 float const *x, void *y)
+{
+    uint32_t channel;
+
+    if (!s) {
+	return;
+    }
+
+    switch (s->bit_depth) {
+    case GDither8bit:
+    case GDither16bit:
+    case GDither32bit:
+    case GDitherPerformanceTest:
+	if (s->type == GDitherNone && s->bit_depth == 8 && s->dither_depth == 8) {
+	    /* same constants as the special case in gdither_runf() */
+	    gdither_none_loop(128.0f, SCALE_U8, 1, 8, length * s->channels, x, y,
+			      MAX_U8, MIN_U8);
+	    return;
+	} else if (s->type == GDitherNone) {
+	    gdither_none_loop(s->bias, s->scale, (int32_t)s->post_scale,
+			      s->bit_depth, length * s->channels, x, y,
+			      (float)s->clamp_u, (float)s->clamp_l);
+	    return;
+	}
+	break;
+    default:
+	break;
+    }
+
+    for (channel = 0; channel < s->channels; channel++) {
+	gdither_runf(s, channel, length, x, y);
+    }
+}
+
 /* vi:set ts=8 sts=4 sw=4: */
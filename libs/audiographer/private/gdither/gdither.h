@@ -81,6 +81,16 @@ void gdither_free(GDither s);
 void gdither_runf(GDither s, uint32_t channel, uint32_t length,
 		   float const *x, void *y);
 
+/* Applies dithering to all channels of an interleaved signal.
+ *
+ * length is the number of frames, x holds length * channels input samples.
+ * This is equivalent to calling gdither_runf() for each channel, but without
+ * dither the samples do not depend on each other and the whole buffer is
+ * converted in a single, branch free loop that the compiler can vectorise.
+ */
+void gdither_runf_interleaved(GDither s, uint32_t length,
+		   float const *x, void *y);
+
 /* see gdither_runf, vut input argument is double format */
 void gdither_run(GDither s, uint32_t channel, uint32_t length,
 		   double const *x, void *y);
@@ -137,11 +137,9 @@ SampleFormatConverter<TOut>::process (ProcessContext<float> const & c_in)
 
 	check_sample_and_channel_count (c_in.samples (), c_in.channels ());
 
-	/* Do conversion */
+	/* Do conversion, all channels at once */
 
-	for (uint32_t chn = 0; chn < c_in.channels(); ++chn) {
-		gdither_runf (dither, chn, c_in.samples_per_channel (), data, data_out);
-	}
+	gdither_runf_interleaved (dither, c_in.samples_per_channel (), data, data_out);
 
 	/* Write forward */
 
@@ -166,12 +164,10 @@ SampleFormatConverter<float>::process (ProcessContext<float> & c_in)
 	float * data = c_in.data();
 
 	if (clip_floats) {
+		/* branch free, so that it can be vectorized */
 		for (samplecnt_t x = 0; x < samples; ++x) {
-			if (data[x] > 1.0f) {
-				data[x] = 1.0f;
-			} else if (data[x] < -1.0f) {
-				data[x] = -1.0f;
-			}
+			float const v = data[x] < 1.0f ? data[x] : 1.0f;
+			data[x] = v > -1.0f ? v : -1.0f;
 		}
 	}
 
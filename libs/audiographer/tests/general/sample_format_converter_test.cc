@@ -1,3 +1,9 @@
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include <glib.h>
+
 #include "tests/utils.h"
 
 #include "audiographer/general/sample_format_converter.h"
@@ -15,6 +21,8 @@ class SampleFormatConverterTest : public CppUnit::TestFixture
   CPPUNIT_TEST (testInt16);
   CPPUNIT_TEST (testUint8);
   CPPUNIT_TEST (testChannelCount);
+  CPPUNIT_TEST (testInterleaved);
+  CPPUNIT_TEST (testPerformance);
   CPPUNIT_TEST_SUITE_END ();
 
   public:
@@ -204,6 +212,61 @@ class SampleFormatConverterTest : public CppUnit::TestFixture
 		CPPUNIT_ASSERT (TestUtils::array_filled(sink->get_array(), pc.samples()));
 	}
 
+	void testInterleaved()
+	{
+		// Without dither all channels are converted in one go, this must match the plain conversion
+		ChannelCount const channels = 4;
+		samplecnt_t const n = samples * channels;
+		float * data = TestUtils::init_random_data (n, 1.5);
+
+		boost::shared_ptr<SampleFormatConverter<int16_t> > converter (new SampleFormatConverter<int16_t>(channels));
+		boost::shared_ptr<VectorSink<int16_t> > sink (new VectorSink<int16_t>());
+
+		converter->init (n, D_None, 16);
+		converter->add_output (sink);
+
+		ProcessContext<float> pc (data, n, channels);
+		converter->process (pc);
+		CPPUNIT_ASSERT_EQUAL (n, (samplecnt_t) sink->get_data().size());
+
+		for (samplecnt_t i = 0; i < n; ++i) {
+			long expected = lrintf (data[i] * 32768.f);
+			expected = std::min (32767L, std::max (-32768L, expected));
+			CPPUNIT_ASSERT_EQUAL ((int16_t) expected, sink->get_data()[i]);
+		}
+
+		delete [] data;
+	}
+
+	void testPerformance()
+	{
+		// Not a test as such, reports the conversion throughput for each dither type
+		ChannelCount const channels = 2;
+		samplecnt_t const n = 8192 * channels;
+		int const iterations = 200;
+		float * data = TestUtils::init_random_data (n, 1.0);
+
+		DitherType const types[] = { D_None, D_Rect, D_Tri, D_Shaped };
+		char const * names[] = { "none", "rect", "tri", "shaped" };
+
+		for (size_t t = 0; t < sizeof (types) / sizeof (types[0]); ++t) {
+			boost::shared_ptr<SampleFormatConverter<int32_t> > converter (new SampleFormatConverter<int32_t>(channels));
+			converter->init (n, types[t], 24);
+
+			ProcessContext<float> pc (data, n, channels);
+			gint64 const start = g_get_monotonic_time ();
+			for (int i = 0; i < iterations; ++i) {
+				converter->process (pc);
+			}
+			gint64 const elapsed = std::max ((gint64) 1, g_get_monotonic_time () - start);
+
+			std::cout << "SampleFormatConverter 24 bit, dither " << names[t] << ": "
+			          << (double) n * iterations / elapsed << " Msamples/s" << std::endl;
+		}
+
+		delete [] data;
+	}
+
   private:
 
 	float * random_data;
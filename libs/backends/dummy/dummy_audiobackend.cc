@@ -34,7 +34,9 @@
 
 #include "pbd/error.h"
 #include "pbd/compose.h"
+#include "pbd/malign.h"
 #include "ardour/port_manager.h"
+#include "ardour/runtime_functions.h"
 #include "pbd/i18n.h"
 
 using namespace ARDOUR;
@@ -59,6 +61,9 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 	, _freewheel (false)
 	, _freewheeling (false)
 	, _speedup (1.0)
+	, _bench_start (0)
+	, _bench_cycles (0)
+	, _bench_samples (0)
 	, _device ("")
 	, _samplerate (48000)
 	, _samples_per_period (1024)
@@ -86,6 +91,7 @@ DummyAudioBackend::DummyAudioBackend (AudioEngine& e, AudioBackendInfo& info)
 		_driver_speed.push_back (DriverSpeed (_("15x Speed"),    0.06666f));
 		_driver_speed.push_back (DriverSpeed (_("20x Speed"),    0.05f));
 		_driver_speed.push_back (DriverSpeed (_("50x Speed"),    0.02f));
+		_driver_speed.push_back (DriverSpeed (_("Benchmark"),    0.0f));
 	}
 
 }
@@ -1322,6 +1328,11 @@ DummyAudioBackend::main_process_thread ()
 
 	int64_t clock1;
 	clock1 = -1;
+
+	_bench_start = _x_get_monotonic_usec();
+	_bench_cycles = 0;
+	_bench_samples = 0;
+
 	while (_running) {
 		const size_t samples_per_period = _samples_per_period;
 
@@ -1379,7 +1390,15 @@ DummyAudioBackend::main_process_thread ()
 
 			const int64_t elapsed_time = _dsp_load_calc.elapsed_time_us ();
 			const int64_t nominal_time = _dsp_load_calc.get_max_time_us ();
-			if (elapsed_time < nominal_time) {
+			if (_speedup == 0) {
+				/* benchmark: start the next cycle right away */
+				++_bench_cycles;
+				_bench_samples += samples_per_period;
+				const int64_t now = _x_get_monotonic_usec();
+				if (now - _bench_start >= 5000000) {
+					bench_report (now);
+				}
+			} else if (elapsed_time < nominal_time) {
 				const int64_t sleepy = _speedup * (nominal_time - elapsed_time);
 				Glib::usleep (std::max ((int64_t) 100, sleepy));
 			} else {
@@ -1424,10 +1443,31 @@ DummyAudioBackend::main_process_thread ()
 		}
 
 	}
+
+	if (_speedup == 0 && _bench_cycles > 0) {
+		bench_report (_x_get_monotonic_usec());
+	}
+
 	_running = false;
 	return 0;
 }
 
+void
+DummyAudioBackend::bench_report (int64_t now)
+{
+	const double elapsed = (now - _bench_start) / 1e6;
+	if (elapsed <= 0) {
+		return;
+	}
+	PBD::info << string_compose (_("DummyAudioBackend: %1 cycles/sec, %2 x realtime (%3 samples per cycle)"),
+			rint (_bench_cycles / elapsed),
+			(_bench_samples / elapsed) / _samplerate,
+			_samples_per_period) << endmsg;
+	_bench_start = now;
+	_bench_cycles = 0;
+	_bench_samples = 0;
+}
+
 
 /******************************************************************************/
 
@@ -1711,10 +1751,12 @@ DummyAudioPort::DummyAudioPort (DummyAudioBackend &b, const std::string& name, P
 	, _ltc (0)
 	, _ltcbuf (0)
 {
-	memset (_buffer, 0, sizeof (_buffer));
+	cache_aligned_malloc ((void**) &_buffer, DummyAudioBackend::max_buffer_size () * sizeof (Sample));
+	memset (_buffer, 0, DummyAudioBackend::max_buffer_size () * sizeof (Sample));
 }
 
 DummyAudioPort::~DummyAudioPort () {
+	cache_aligned_free (_buffer);
 	free(_wavetable);
 	ltc_encoder_free (_ltc);
 	delete _ltcbuf;
@@ -2133,18 +2175,14 @@ void* DummyAudioPort::get_buffer (pframes_t n_samples)
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
-			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
+			copy_vector (_buffer, source->const_buffer (), n_samples);
 			while (++it != connections.end ()) {
 				source = static_cast<DummyAudioPort*>(*it);
 				assert (source && source->is_output ());
-				Sample* dst = buffer ();
 				if (source->is_physical() && source->is_terminal()) {
 					source->get_buffer(n_samples); // generate signal.
 				}
-				const Sample* src = source->const_buffer ();
-				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
-					*dst += *src;
-				}
+				mix_buffers_no_gain (_buffer, source->const_buffer (), n_samples);
 			}
 		}
 	} else if (is_output () && is_physical () && is_terminal()) {
@@ -170,7 +170,7 @@ class DummyAudioPort : public DummyPort {
 		void midi_to_wavetable (DummyMidiBuffer const * const src, size_t n_samples);
 
 	private:
-		Sample _buffer[8192];
+		Sample* _buffer; // cache-aligned, DummyAudioBackend::max_buffer_size () samples
 
 		// signal generator ('fake' physical inputs)
 		void generate (const pframes_t n_samples);
@@ -407,7 +407,13 @@ class DummyAudioBackend : public AudioBackend {
 		bool  _running;
 		bool  _freewheel;
 		bool  _freewheeling;
-		float _speedup;
+		float _speedup; // 0: benchmark, run cycles back-to-back
+
+		/* benchmark statistics */
+		int64_t  _bench_start;
+		uint64_t _bench_cycles;
+		samplecnt_t _bench_samples;
+		void bench_report (int64_t now);
 
 		std::string _device;
 
@@ -19,8 +19,10 @@
 #ifndef EVORAL_CONTROL_LIST_HPP
 #define EVORAL_CONTROL_LIST_HPP
 
+#include <algorithm>
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -245,7 +247,36 @@ public:
 		ControlList::const_iterator first;
 	};
 
+	/** Contiguous copy of the event list (one array per field), rebuilt
+	 * with the write-lock held after changes.  Changes made during a write
+	 * pass or while the list is frozen only mark it stale; it is rebuilt
+	 * once, when the pass is finished or the list is thawed.  Readers can
+	 * binary search it instead of walking the list; they never modify it,
+	 * so evaluation does not allocate.
+	 *
+	 * Only valid while the event list is sorted and the index is not
+	 * stale, otherwise readers must fall back to the list (and the lookup
+	 * caches).
+	 */
+	struct EventIndex {
+		EventIndex () : valid (false), stale (false) {}
+
+		/** @return position of the first event at or after @param x */
+		size_t lower_bound (double x) const {
+			return std::lower_bound (when.begin(), when.end(), x) - when.begin();
+		}
+
+		size_t size () const { return when.size(); }
+
+		std::vector<double>         when;
+		std::vector<double>         value;
+		std::vector<const_iterator> iter;
+		bool                        valid;
+		bool                        stale; // events changed, rebuild when done
+	};
+
 	const EventList& events() const { return _events; }
+	const EventIndex& event_index() const { return _event_index; }
 
 	// FIXME: const violations for Curve
 	Glib::Threads::RWLock& lock()       const { return _lock; }
@@ -272,6 +303,11 @@ public:
 
 	void mark_dirty () const;
 
+	/** @return a value that changes whenever the list is modified,
+	 * e.g. to tell whether a serialized copy is still current.
+	 */
+	gint serial () const { return g_atomic_int_get (&_serial); }
+
 	enum InterpolationStyle {
 		Discrete,
 		Linear,
@@ -324,6 +360,11 @@ protected:
 
 	void build_search_cache_if_necessary (double start) const;
 
+	void unlocked_update_index ();
+	void unlocked_rebuild_index ();
+	void unlocked_invalidate_index ();
+	void rebuild_index_if_stale ();
+
 	boost::shared_ptr<ControlList> cut_copy_clear (double, double, int op);
 	bool erase_range_internal (double start, double end, EventList &);
 
@@ -337,6 +378,8 @@ protected:
 
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
+	EventIndex            _event_index;
+	mutable gint          _serial;
 
 	mutable Glib::Threads::RWLock _lock;
 
@@ -23,11 +23,10 @@
 #include <boost/utility.hpp>
 
 #include "evoral/visibility.h"
+#include "evoral/ControlList.hpp"
 
 namespace Evoral {
 
-class ControlList;
-
 class LIBEVORAL_API Curve : public boost::noncopyable
 {
 public:
@@ -42,6 +41,7 @@ public:
 
 private:
 	double multipoint_eval (double x) const;
+	double indexed_eval (ControlList::EventIndex const& index, double x, size_t after) const;
 
 	void _get_vector (double x0, double x1, float *arg, int32_t veclen) const;
 
@@ -119,16 +119,26 @@ public:
 		return a->time() < b->time();
 	}
 
+	/* The comparators take their arguments by reference and have an overload
+	 * for NotePtr, so that comparing two notes does not create temporary
+	 * shared_ptr<const Note> (and the atomic reference count updates that
+	 * come with them). Containers of notes perform a lot of comparisons.
+	 */
+
 	struct NoteNumberComparator {
-		inline bool operator()(const boost::shared_ptr< const Note<Time> > a,
-		                       const boost::shared_ptr< const Note<Time> > b) const {
+		inline bool operator()(const NotePtr& a, const NotePtr& b) const {
+			return a->note() < b->note();
+		}
+		inline bool operator()(const constNotePtr& a, const constNotePtr& b) const {
 			return a->note() < b->note();
 		}
 	};
 
 	struct EarlierNoteComparator {
-		inline bool operator()(const boost::shared_ptr< const Note<Time> > a,
-		                       const boost::shared_ptr< const Note<Time> > b) const {
+		inline bool operator()(const NotePtr& a, const NotePtr& b) const {
+			return a->time() < b->time();
+		}
+		inline bool operator()(const constNotePtr& a, const constNotePtr& b) const {
 			return a->time() < b->time();
 		}
 	};
@@ -145,8 +155,10 @@ public:
 
 	struct LaterNoteEndComparator {
 		typedef const Note<Time>* value_type;
-		inline bool operator()(const boost::shared_ptr< const Note<Time> > a,
-		                       const boost::shared_ptr< const Note<Time> > b) const {
+		inline bool operator()(const NotePtr& a, const NotePtr& b) const {
+			return a->end_time().to_double() > b->end_time().to_double();
+		}
+		inline bool operator()(const constNotePtr& a, const constNotePtr& b) const {
 			return a->end_time().to_double() > b->end_time().to_double();
 		}
 	};
@@ -190,7 +202,10 @@ public:
 	typedef boost::shared_ptr<const Event<Time> > constSysExPtr;
 
 	struct EarlierSysExComparator {
-		inline bool operator() (constSysExPtr a, constSysExPtr b) const {
+		inline bool operator() (const SysExPtr& a, const SysExPtr& b) const {
+			return a->time() < b->time();
+		}
+		inline bool operator() (const constSysExPtr& a, const constSysExPtr& b) const {
 			return a->time() < b->time();
 		}
 	};
@@ -203,7 +218,10 @@ public:
 	typedef boost::shared_ptr<const PatchChange<Time> > constPatchChangePtr;
 
 	struct EarlierPatchChangeComparator {
-		inline bool operator() (constPatchChangePtr a, constPatchChangePtr b) const {
+		inline bool operator() (const PatchChangePtr& a, const PatchChangePtr& b) const {
+			return a->time() < b->time();
+		}
+		inline bool operator() (const constPatchChangePtr& a, const constPatchChangePtr& b) const {
 			return a->time() < b->time();
 		}
 	};
@@ -323,7 +341,17 @@ protected:
 		return 0;
 	}
 
-	typedef std::multiset<NotePtr, NoteNumberComparator>  Pitches;
+	/** Orders notes by note number, and notes with the same number by time,
+	 * so that a note (or the notes of one pitch in a time range) can be
+	 * found without visiting every note of that pitch.
+	 */
+	struct NoteNumberTimeComparator {
+		inline bool operator()(const NotePtr& a, const NotePtr& b) const {
+			return a->note() < b->note() || (a->note() == b->note() && a->time() < b->time());
+		}
+	};
+
+	typedef std::multiset<NotePtr, NoteNumberTimeComparator>  Pitches;
 	inline       Pitches& pitches(uint8_t chan)       { return _pitches[chan&0xf]; }
 	inline const Pitches& pitches(uint8_t chan) const { return _pitches[chan&0xf]; }
 
@@ -333,6 +361,7 @@ private:
 	friend class const_iterator;
 
 	bool overlaps_unlocked (const NotePtr& ev, const NotePtr& ignore_this_note) const;
+	void erase_pitch_unlocked (const NotePtr&);
 	bool contains_unlocked (const NotePtr& ev) const;
 
 	void append_note_on_unlocked(const Event<Time>& event, Evoral::event_id_t);
@@ -61,6 +61,7 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc)
 	, _curve(0)
 {
 	_frozen = 0;
+	_serial = 0;
 	_changed_when_thawed = false;
 	_lookup_cache.left = -1;
 	_lookup_cache.range.first = _events.end();
@@ -82,6 +83,7 @@ ControlList::ControlList (const ControlList& other)
 	, _curve(0)
 {
 	_frozen = 0;
+	_serial = 0;
 	_changed_when_thawed = false;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
@@ -104,6 +106,7 @@ ControlList::ControlList (const ControlList& other, double start, double end)
 	, _curve(0)
 {
 	_frozen = 0;
+	_serial = 0;
 	_changed_when_thawed = false;
 	_lookup_cache.range.first = _events.end();
 	_lookup_cache.range.second = _events.end();
@@ -189,6 +192,7 @@ ControlList::copy_events (const ControlList& other)
 			_events.push_back (new ControlEvent ((*i)->when, (*i)->value));
 		}
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -238,6 +242,7 @@ ControlList::clear ()
 		}
 		_events.clear ();
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -271,6 +276,7 @@ ControlList::y_transform (boost::function<double(double)> callback)
 		for (iterator i = _events.begin(); i != _events.end(); ++i) {
 			(*i)->value = callback ((*i)->value);
 		}
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -318,6 +324,7 @@ ControlList::list_merge (ControlList const& other, boost::function<double(double
 
 		unlocked_remove_duplicates ();
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -330,6 +337,7 @@ ControlList::_x_scale (double factor)
 		(*i)->when *= factor;
 	}
 
+	unlocked_update_index ();
 	mark_dirty ();
 }
 
@@ -399,6 +407,7 @@ ControlList::thin (double thinning_factor)
 
 		if (changed) {
 			unlocked_invalidate_insert_iterator ();
+			unlocked_update_index ();
 			mark_dirty ();
 		}
 	}
@@ -415,10 +424,19 @@ ControlList::fast_simple_add (double when, double value)
 	/* to be used only for loading pre-sorted data from saved state */
 	_events.insert (_events.end(), new ControlEvent (when, value));
 
-	mark_dirty ();
 	if (_frozen) {
 		_sort_pending = true;
+		unlocked_invalidate_index ();
+	} else if (_event_index.valid && _event_index.size() + 1 == _events.size()) {
+		/* data is pre-sorted, extend the index instead of rebuilding it */
+		_event_index.when.push_back (when);
+		_event_index.value.push_back (value);
+		_event_index.iter.push_back (--_events.end());
+	} else {
+		unlocked_update_index ();
 	}
+
+	mark_dirty ();
 }
 
 void
@@ -434,6 +452,70 @@ ControlList::unlocked_invalidate_insert_iterator ()
 	most_recent_insert_iterator = _events.end();
 }
 
+/** Bring the event index up to date after a change to the events.  The
+ * caller must hold the write-lock, and must call this after any change
+ * to the events.  During a write pass or while the list is frozen the
+ * index is only marked stale, see rebuild_index_if_stale().
+ */
+void
+ControlList::unlocked_update_index ()
+{
+	if (_sort_pending) {
+		/* events are not in time-order until thaw() */
+		unlocked_invalidate_index ();
+		return;
+	}
+
+	if (_in_write_pass || _frozen) {
+		/* more changes are coming, rebuild once they're done */
+		_event_index.valid = false;
+		_event_index.stale = true;
+		return;
+	}
+
+	unlocked_rebuild_index ();
+}
+
+/** Rebuild the event index from the event list.  The caller must hold the
+ * write-lock.
+ */
+void
+ControlList::unlocked_rebuild_index ()
+{
+	const size_t n = _events.size();
+
+	_event_index.when.resize (n);
+	_event_index.value.resize (n);
+	_event_index.iter.resize (n);
+
+	size_t k = 0;
+	for (const_iterator i = _events.begin(); i != _events.end(); ++i, ++k) {
+		_event_index.when[k]  = (*i)->when;
+		_event_index.value[k] = (*i)->value;
+		_event_index.iter[k]  = i;
+	}
+
+	_event_index.valid = true;
+	_event_index.stale = false;
+}
+
+void
+ControlList::unlocked_invalidate_index ()
+{
+	_event_index.valid = false;
+	_event_index.stale = false;
+}
+
+/** Rebuild the event index if changes were made while it was deferred */
+void
+ControlList::rebuild_index_if_stale ()
+{
+	Glib::Threads::RWLock::WriterLock lm (_lock);
+	if (_event_index.stale && !_in_write_pass && !_frozen) {
+		unlocked_rebuild_index ();
+	}
+}
+
 void
 ControlList::unlocked_remove_duplicates ()
 {
@@ -476,6 +558,7 @@ ControlList::start_write_pass (double when)
 	if (_in_write_pass && !new_write_pass) {
 #if 1
 		add_guard_point (when, 0); // also sets most_recent_insert_iterator
+		unlocked_update_index ();
 #else
 		const ControlEvent cp (when, 0.0);
 		most_recent_insert_iterator = lower_bound (_events.begin(), _events.end(), &cp, time_comparator);
@@ -494,6 +577,8 @@ ControlList::write_pass_finished (double /*when*/, double thinning_factor)
 	}
 	new_write_pass = true;
 	_in_write_pass = false;
+
+	rebuild_index_if_stale ();
 }
 
 void
@@ -506,6 +591,9 @@ ControlList::set_in_write_pass (bool yn, bool add_point, double when)
 	if (yn && add_point) {
 		Glib::Threads::RWLock::WriterLock lm (_lock);
 		add_guard_point (when, 0);
+		unlocked_update_index ();
+	} else if (!yn) {
+		rebuild_index_if_stale ();
 	}
 }
 
@@ -608,6 +696,8 @@ ControlList::editor_add (double when, double value, bool with_guard)
 			return false;
 		}
 
+		unlocked_invalidate_index ();
+
 		/* clamp new value to allowed range */
 		value = std::min ((double)_desc.upper, std::max ((double)_desc.lower, value));
 
@@ -638,6 +728,7 @@ ControlList::editor_add (double when, double value, bool with_guard)
 			return false;
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -731,6 +822,12 @@ ControlList::add (double when, double value, bool with_guards, bool with_initial
 		ControlEvent cp (when, 0.0f);
 		iterator insertion_point;
 
+		/* the list is modified piecemeal below, and evaluated in
+		 * between (by add_guard_point); use the list itself until
+		 * we're done.
+		 */
+		unlocked_invalidate_index ();
+
 		if (_events.empty() && with_initial) {
 
 			/* empty: add an "anchor" point if the point we're adding past time 0 */
@@ -866,6 +963,7 @@ ControlList::add (double when, double value, bool with_guards, bool with_initial
 			}
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -881,6 +979,7 @@ ControlList::erase (iterator i)
 			unlocked_invalidate_insert_iterator ();
 		}
 		_events.erase (i);
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -893,6 +992,7 @@ ControlList::erase (iterator start, iterator end)
 		Glib::Threads::RWLock::WriterLock lm (_lock);
 		_events.erase (start, end);
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 	maybe_signal_changed ();
@@ -917,6 +1017,7 @@ ControlList::erase (double when, double value)
 			}
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -933,6 +1034,7 @@ ControlList::erase_range (double start, double endt)
 		erased = erase_range_internal (start, endt, _events);
 
 		if (erased) {
+			unlocked_update_index ();
 			mark_dirty ();
 		}
 
@@ -979,6 +1081,7 @@ ControlList::slide (iterator before, double distance)
 			++before;
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -997,6 +1100,7 @@ ControlList::shift (double pos, double frames)
 			}
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -1031,6 +1135,7 @@ ControlList::modify (iterator iter, double when, double val)
 			_sort_pending = true;
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -1093,6 +1198,10 @@ ControlList::thaw ()
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
+			unlocked_update_index ();
+			g_atomic_int_inc (&_serial);
+		} else if (_event_index.stale && !_in_write_pass) {
+			unlocked_rebuild_index ();
 		}
 	}
 }
@@ -1110,6 +1219,8 @@ ControlList::mark_dirty () const
 		_curve->mark_dirty();
 	}
 
+	g_atomic_int_inc (&_serial);
+
 	Dirty (); /* EMIT SIGNAL */
 }
 
@@ -1210,6 +1321,7 @@ ControlList::truncate_end (double last_coordinate)
 		}
 
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty();
 	}
 
@@ -1311,6 +1423,7 @@ ControlList::truncate_start (double overall_length)
 		}
 
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty();
 	}
 
@@ -1389,6 +1502,45 @@ ControlList::multipoint_eval (double x) const
 	double uval, lval;
 	double fraction;
 
+	const EventIndex& index (_event_index);
+
+	if (index.valid) {
+		/* binary search the index; unlocked_eval() has already
+		 * handled x at or outside the first and last point.
+		 */
+		const size_t n = index.size();
+		const size_t u = index.lower_bound (x);
+
+		if (u == n) {
+			return index.value[n-1];
+		}
+
+		if (u == 0 || index.when[u] == x) {
+			return index.value[u];
+		}
+
+		lpos = index.when[u-1];
+		lval = index.value[u-1];
+		upos = index.when[u];
+		uval = index.value[u];
+
+		fraction = (double) (x - lpos) / (double) (upos - lpos);
+
+		switch (_interpolation) {
+			case Discrete:
+				return lval;
+			case Logarithmic:
+				return interpolate_logarithmic (lval, uval, fraction, _desc.lower, _desc.upper);
+			case Exponential:
+				return interpolate_gain (lval, uval, fraction, _desc.upper);
+			case Curved:
+				/* only used x-fade curves, never direct eval */
+				assert (0);
+			default: // Linear
+				return interpolate_linear (lval, uval, fraction);
+		}
+	}
+
 	/* "Stepped" lookup (no interpolation) */
 	/* FIXME: no cache.  significant? */
 	if (_interpolation == Discrete) {
@@ -1478,9 +1630,14 @@ ControlList::build_search_cache_if_necessary (double start) const
 	} else if ((_search_cache.left < 0) || (_search_cache.left > start)) {
 		/* Marked dirty (left < 0), or we're too far forward, re-search. */
 
-		const ControlEvent start_point (start, 0);
-
-		_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
+		const EventIndex& index (_event_index);
+		if (index.valid) {
+			const size_t k = index.lower_bound (start);
+			_search_cache.first = (k < index.size()) ? index.iter[k] : _events.end();
+		} else {
+			const ControlEvent start_point (start, 0);
+			_search_cache.first = lower_bound (_events.begin(), _events.end(), &start_point, time_comparator);
+		}
 		_search_cache.left = start;
 	}
 
@@ -1786,6 +1943,7 @@ ControlList::cut_copy_clear (double start, double end, int op)
 		}
 
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -1876,6 +2034,7 @@ ControlList::paste (const ControlList& alist, double pos)
 		}
 
 		unlocked_invalidate_insert_iterator ();
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -1938,6 +2097,7 @@ ControlList::move_ranges (const list< RangeMove<double> >& movements)
 			_sort_pending = true;
 		}
 
+		unlocked_update_index ();
 		mark_dirty ();
 	}
 
@@ -360,16 +360,91 @@ Curve::_get_vector (double x0, double x1, float *vec, int32_t veclen) const
 		dx = (hx - lx) / (veclen - 1);
 	}
 
+	const ControlList::EventIndex& index (_list.event_index());
+
+	if (index.valid) {
+		/* rx only ever increases: binary search once, then walk */
+		const size_t n = index.size();
+		size_t after = index.lower_bound (rx);
+		for (i = 0; i < veclen; ++i, rx += dx) {
+			while (after < n && index.when[after] < rx) {
+				++after;
+			}
+			vec[i] = indexed_eval (index, rx, after);
+		}
+		return;
+	}
+
 	for (i = 0; i < veclen; ++i, rx += dx) {
 		vec[i] = multipoint_eval (rx);
 	}
 }
 
+/** Evaluate at @param x using the list's event index.
+ *  @param index the list's event index, which must be valid
+ *  @param after position of the first event at or after x
+ */
+double
+Curve::indexed_eval (ControlList::EventIndex const& index, double x, size_t after) const
+{
+	if (after == 0) {
+		/* we're before the first point */
+		return index.value[0];
+	}
+
+	if (after == index.size()) {
+		/* we're after the last point */
+		return index.value[after - 1];
+	}
+
+	if (index.when[after] == x) {
+		/* x is a control point in the data */
+		return index.value[after];
+	}
+
+	const double before_when  = index.when[after - 1];
+	const double before_value = index.value[after - 1];
+	const double after_value  = index.value[after];
+
+	double vdelta = after_value - before_value;
+
+	if (vdelta == 0.0) {
+		return before_value;
+	}
+
+	double tdelta = x - before_when;
+	double trange = index.when[after] - before_when;
+
+	switch (_list.interpolation()) {
+		case ControlList::Discrete:
+			return before_value;
+		case ControlList::Logarithmic:
+			return interpolate_logarithmic (before_value, after_value, tdelta / trange, _list.descriptor().lower, _list.descriptor().upper);
+		case ControlList::Exponential:
+			return interpolate_gain (before_value, after_value, tdelta / trange, _list.descriptor().upper);
+		case ControlList::Curved:
+			if ((*index.iter[after])->coeff) {
+				const ControlEvent* ev = *index.iter[after];
+				double x2 = x * x;
+				return ev->coeff[0] + (ev->coeff[1] * x) + (ev->coeff[2] * x2) + (ev->coeff[3] * x2 * x);
+			}
+			// no break, fallthru
+		default: // Linear
+			return before_value + (vdelta * (tdelta / trange));
+	}
+}
+
 double
 Curve::multipoint_eval (double x) const
 {
 	pair<ControlList::EventList::const_iterator,ControlList::EventList::const_iterator> range;
 
+	const ControlList::EventIndex& index (_list.event_index());
+
+	if (index.valid) {
+		return indexed_eval (index, x, index.lower_bound (x));
+	}
+
 	ControlList::LookupCache& lookup_cache = _list.lookup_cache();
 
 	if ((lookup_cache.left < 0) ||
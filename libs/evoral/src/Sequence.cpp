@@ -24,6 +24,8 @@
 #include <stdint.h>
 #include <cstdio>
 
+#include <boost/make_shared.hpp>
+
 #if __clang__
 #include "evoral/Note.hpp"
 #endif
@@ -493,8 +495,10 @@ Sequence<Time>::Sequence(const Sequence<Time>& other)
 	, _highest_note(other._highest_note)
 {
 	for (typename Notes::const_iterator i = other._notes.begin(); i != other._notes.end(); ++i) {
-		NotePtr n (new Note<Time> (**i));
-		_notes.insert (n);
+		NotePtr n (boost::make_shared<Note<Time> > (**i));
+		/* other._notes is sorted, appending at the end is amortized constant time */
+		_notes.insert (_notes.end(), n);
+		_pitches[n->channel()].insert (n);
 	}
 
 	for (typename SysExes::const_iterator i = other._sysexes.begin(); i != other._sysexes.end(); ++i) {
@@ -612,6 +616,9 @@ Sequence<Time>::clear()
 {
 	WriteLock lock(write_lock());
 	_notes.clear();
+	for (int i = 0; i < 16; ++i) {
+		_pitches[i].clear();
+	}
 	for (Controls::iterator li = _controls.begin(); li != _controls.end(); ++li)
 		li->second->list()->clear();
 }
@@ -663,13 +670,15 @@ Sequence<Time>::end_write (StuckNoteOption option, Time when)
 				break;
 			case DeleteStuckNotes:
 				cerr << "WARNING: Stuck note lost: " << (*n)->note() << endl;
+				erase_pitch_unlocked (*n);
 				_notes.erase(n);
 				break;
 			case ResolveStuckNotes:
 				if (when <= (*n)->time()) {
 					cerr << "WARNING: Stuck note resolution - end time @ "
 					     << when << " is before note on: " << (**n) << endl;
-					_notes.erase (*n);
+					erase_pitch_unlocked (*n);
+					_notes.erase (n);
 				} else {
 					(*n)->set_length (when - (*n)->time());
 					cerr << "WARNING: resolved note-on with no note-off to generate " << (**n) << endl;
@@ -712,7 +721,14 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	if (note->note() > _highest_note)
 		_highest_note = note->note();
 
-	_notes.insert (note);
+	if (_notes.empty() || !(note->time() < (*_notes.rbegin())->time())) {
+		/* common case when loading or recording: the note is (one of) the
+		 * latest, inserting at the end is amortized constant time.
+		 */
+		_notes.insert (_notes.end(), note);
+	} else {
+		_notes.insert (note);
+	}
 	_pitches[note->channel()].insert (note);
 
 	_edited = true;
@@ -720,6 +736,21 @@ Sequence<Time>::add_note_unlocked(const NotePtr note, void* arg)
 	return true;
 }
 
+/** Remove @a note from the pitch index, using its current note number and time. */
+template<typename Time>
+void
+Sequence<Time>::erase_pitch_unlocked (const NotePtr& note)
+{
+	Pitches& p (pitches (note->channel()));
+
+	for (typename Pitches::iterator j = p.lower_bound (note); j != p.end() && (*j)->note() == note->note() && (*j)->time() == note->time(); ++j) {
+		if (*j == note) {
+			p.erase (j);
+			return;
+		}
+	}
+}
+
 template<typename Time>
 void
 Sequence<Time>::remove_note_unlocked(const constNotePtr note)
@@ -829,13 +860,12 @@ Sequence<Time>::remove_note_unlocked(const constNotePtr note)
 		} else {
 
 			/* Now find the same note in the "pitches" list (which indexes
-			 * notes by channel+time. We care only about its note number
-			 * so the search_note has all other properties unset.
+			 * notes by channel, note number and time).
 			 */
 
-			NotePtr search_note (new Note<Time>(0, Time(), Time(), note->note(), 0));
+			NotePtr search_note (new Note<Time>(0, note->time(), Time(), note->note(), 0));
 
-			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note(); ++j) {
+			for (j = p.lower_bound (search_note); j != p.end() && (*j)->note() == note->note() && (*j)->time() == note->time(); ++j) {
 
 				if ((*j) == note) {
 					DEBUG_TRACE (DEBUG::Sequence, string_compose ("%1\terasing pitch %2 @ %3\n", this, (int)(*j)->note(), (*j)->time()));
@@ -989,7 +1019,7 @@ Sequence<Time>::append_note_on_unlocked (const Event<Time>& ev, event_id_t evid)
 		return;
 	}
 
-	NotePtr note(new Note<Time>(ev.channel(), ev.time(), Time(), ev.note(), ev.velocity()));
+	NotePtr note (boost::make_shared<Note<Time> > (ev.channel(), ev.time(), Time(), ev.note(), ev.velocity()));
 	note->set_id (evid);
 
 	add_note_unlocked (note);
@@ -1131,10 +1161,10 @@ bool
 Sequence<Time>::contains_unlocked (const NotePtr& note) const
 {
 	const Pitches& p (pitches (note->channel()));
-	NotePtr search_note(new Note<Time>(0, Time(), Time(), note->note()));
+	NotePtr search_note(new Note<Time>(0, note->time(), Time(), note->note()));
 
 	for (typename Pitches::const_iterator i = p.lower_bound (search_note);
-	     i != p.end() && (*i)->note() == note->note(); ++i) {
+	     i != p.end() && (*i)->note() == note->note() && (*i)->time() == note->time(); ++i) {
 
 		if (**i == *note) {
 			return true;
@@ -1172,6 +1202,11 @@ Sequence<Time>::overlaps_unlocked (const NotePtr& note, const NotePtr& without)
 		Time sb = (*i)->time();
 		Time eb = (*i)->end_time();
 
+		if (sb > ea) {
+			/* notes of this pitch are sorted by time, none of the remaining ones can overlap */
+			break;
+		}
+
 		if (((sb > sa) && (eb <= ea)) ||
 		    ((eb >= sa) && (eb <= ea)) ||
 		    ((sb > sa) && (sb <= ea)) ||
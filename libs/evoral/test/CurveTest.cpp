@@ -293,6 +293,109 @@ CurveTest::ctrlListEval ()
 	CPPUNIT_ASSERT_EQUAL(9.0, cl->unlocked_eval(999.));
 }
 
+void
+CurveTest::denseIndexedEval ()
+{
+	float vec[1024];
+	float ref[1024];
+
+	/* "indexed" is evaluated using the event index, "walked" is left
+	 * frozen with unsorted-data pending, which makes it use the list.
+	 */
+	boost::shared_ptr<Evoral::ControlList> indexed = TestCtrlList();
+	boost::shared_ptr<Evoral::ControlList> walked = TestCtrlList();
+
+	indexed->create_curve ();
+	walked->create_curve ();
+	walked->freeze ();
+
+	for (int i = 0; i < 20000; ++i) {
+		const double v = (i % 7) * .125 + (i % 3) * .25;
+		indexed->fast_simple_add (i * 10.0, v);
+		walked->fast_simple_add (i * 10.0, v);
+	}
+
+	CPPUNIT_ASSERT (indexed->event_index().valid);
+	CPPUNIT_ASSERT (!walked->event_index().valid);
+
+	for (int s = 0; s < 2; ++s) {
+		const ControlList::InterpolationStyle style = s ? ControlList::Discrete : ControlList::Linear;
+		indexed->set_interpolation (style);
+		walked->set_interpolation (style);
+
+		for (double x = -15.0; x < 200020.0; x += 333.25) {
+			CPPUNIT_ASSERT_EQUAL (walked->unlocked_eval (x), indexed->unlocked_eval (x));
+		}
+	}
+
+	indexed->set_interpolation (ControlList::Linear);
+	walked->set_interpolation (ControlList::Linear);
+
+	indexed->curve ().get_vector (12345.0, 23456.0, vec, 1024);
+	walked->curve ().get_vector (12345.0, 23456.0, ref, 1024);
+	for (int i = 0; i < 1024; ++i) {
+		CPPUNIT_ASSERT_EQUAL (ref[i], vec[i]);
+	}
+
+	/* the index must follow edits */
+	indexed->erase_range (5000.0, 6000.0);
+	CPPUNIT_ASSERT (indexed->event_index().valid);
+	CPPUNIT_ASSERT_EQUAL (indexed->size (), indexed->event_index().size ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.75, indexed->unlocked_eval (5500.0), 1e-9);
+
+	indexed->shift (0, 5.0);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (0.0, indexed->unlocked_eval (5.0), 1e-9);
+
+	walked->thaw ();
+	CPPUNIT_ASSERT (walked->event_index().valid);
+}
+
+void
+CurveTest::incrementalIndexedEval ()
+{
+	boost::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	/* one event at a time, outside a write pass: each add() updates the
+	 * index before the write-lock is released.
+	 */
+	for (int i = 0; i < 2000; ++i) {
+		cl->add (i * 10.0, (i % 5) * .25, false, false);
+		if (i % 100 == 99) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL ((i % 5) * .25, cl->unlocked_eval (i * 10.0), 1e-9);
+		}
+	}
+
+	CPPUNIT_ASSERT (cl->event_index().valid);
+	CPPUNIT_ASSERT_EQUAL (cl->size (), cl->event_index().size ());
+
+	for (int i = 1; i < 2000; i += 7) {
+		CPPUNIT_ASSERT_DOUBLES_EQUAL ((i % 5) * .25, cl->unlocked_eval (i * 10.0), 1e-9);
+		CPPUNIT_ASSERT_DOUBLES_EQUAL (((i % 5) * .25 + ((i + 1) % 5) * .25) / 2.0, cl->unlocked_eval (i * 10.0 + 5.0), 1e-9);
+	}
+
+	/* inserting in the middle */
+	cl->add (10005.0, .75, false, false);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.75, cl->unlocked_eval (10005.0), 1e-9);
+	CPPUNIT_ASSERT_EQUAL (cl->size (), cl->event_index().size ());
+
+	/* during a write pass, lookups use the list; the index is rebuilt
+	 * once the pass is finished.
+	 */
+	cl->start_write_pass (20000.0);
+	cl->set_in_write_pass (true);
+	for (int i = 2000; i < 2500; ++i) {
+		cl->add (i * 10.0, (i % 5) * .25, false, false);
+	}
+
+	CPPUNIT_ASSERT (!cl->event_index().valid);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (.5, cl->unlocked_eval (20020.0), 1e-9);
+
+	cl->write_pass_finished (25000.0);
+	CPPUNIT_ASSERT (cl->event_index().valid);
+	CPPUNIT_ASSERT_EQUAL (cl->size (), cl->event_index().size ());
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (1.0, cl->unlocked_eval (24990.0), 1e-9);
+}
+
 void
 CurveTest::constrainedCubic ()
 {
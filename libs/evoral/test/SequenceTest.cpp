@@ -194,3 +194,46 @@ SequenceTest::controlInterpolationTest ()
 		last_value = i->second;
 	}
 }
+
+void
+SequenceTest::pitchIndexTest ()
+{
+	typedef Sequence<Time>::NotePtr NotePtr;
+
+	/* many notes of the same pitch, added out of order */
+	vector<NotePtr> notes;
+	for (int i = 0; i < 64; ++i) {
+		int const t = (i * 37) % 64;
+		notes.push_back (NotePtr (new Note<Time> (0, Beats (t * 10), Beats (5), 60 + (t % 2), 64)));
+		CPPUNIT_ASSERT (seq->add_note_unlocked (notes.back ()));
+	}
+	CPPUNIT_ASSERT_EQUAL (size_t (64), seq->notes ().size ());
+
+	for (vector<NotePtr>::const_iterator i = notes.begin (); i != notes.end (); ++i) {
+		CPPUNIT_ASSERT (seq->contains (*i));
+	}
+
+	/* the time index is sorted */
+	Time prev;
+	for (Sequence<Time>::Notes::const_iterator i = seq->notes ().begin (); i != seq->notes ().end (); ++i) {
+		CPPUNIT_ASSERT (prev <= (*i)->time ());
+		prev = (*i)->time ();
+	}
+
+	/* overlaps are found within a pitch, and only there */
+	NotePtr inside (new Note<Time> (0, Beats (201), Beats (2), 60, 64));
+	NotePtr between (new Note<Time> (0, Beats (206), Beats (2), 60, 64));
+	NotePtr other_pitch (new Note<Time> (0, Beats (201), Beats (2), 62, 64));
+	CPPUNIT_ASSERT (seq->overlaps (inside, NotePtr ()));
+	CPPUNIT_ASSERT (!seq->overlaps (between, NotePtr ()));
+	CPPUNIT_ASSERT (!seq->overlaps (other_pitch, NotePtr ()));
+
+	/* removal keeps both indices consistent */
+	for (size_t i = 0; i < notes.size (); i += 2) {
+		seq->remove_note_unlocked (notes[i]);
+	}
+	CPPUNIT_ASSERT_EQUAL (size_t (32), seq->notes ().size ());
+	for (size_t i = 0; i < notes.size (); ++i) {
+		CPPUNIT_ASSERT_EQUAL (i % 2 == 1, seq->contains (notes[i]));
+	}
+}
@@ -132,7 +132,8 @@ public:
 
 	static PBD::Signal1<void, boost::weak_ptr<PBD::Controllable> > GUIFocusChanged;
 
-	PBD::Signal2<void,bool,PBD::Controllable::GroupControlDisposition> Changed;
+	/** emitted from realtime threads (e.g. automation), connecting does not block emission */
+	PBD::RTSignal2<void,bool,PBD::Controllable::GroupControlDisposition> Changed;
 
 	int set_state (const XMLNode&, int version);
 	virtual XMLNode& get_state ();
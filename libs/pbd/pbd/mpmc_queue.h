@@ -0,0 +1,159 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __pbd_mpmc_queue_h__
+#define __pbd_mpmc_queue_h__
+
+#include <cassert>
+#include <glib.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** A fixed-size, lock-free multi-producer, multi-consumer queue
+ * (after Dmitry Vyukov's bounded MPMC queue).
+ *
+ * Every cell carries a sequence number which tells producers and
+ * consumers whether the cell is free for the current lap of the ring.
+ * The queue never allocates after construction or reserve(),
+ * push_back() fails if it is full.
+ */
+template<class T>
+class /*LIBPBD_API*/ MPMCQueue
+{
+  public:
+	MPMCQueue (guint sz = 8)
+		: _buffer (0)
+		, _buffer_mask (0)
+	{
+		reserve (sz);
+	}
+
+	~MPMCQueue () {
+		delete [] _buffer;
+	}
+
+	static guint power_of_two_size (guint sz) {
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		return 1U<<power_of_two;
+	}
+
+	/** grow the queue to hold at least @a sz items.
+	 * !!! NOT THREAD SAFE, discards queued items !!!
+	 * @return true if the queue was reallocated
+	 */
+	bool reserve (guint sz) {
+		sz = power_of_two_size (sz);
+		if (_buffer && _buffer_mask + 1 >= sz) {
+			return false;
+		}
+		delete [] _buffer;
+		_buffer = new cell_t[sz];
+		_buffer_mask = sz - 1;
+		clear ();
+		return true;
+	}
+
+	void clear () {
+		/* !!! NOT THREAD SAFE !!! */
+		for (guint i = 0; i <= _buffer_mask; ++i) {
+			g_atomic_int_set (&_buffer[i]._sequence, i);
+		}
+		g_atomic_int_set (&_enqueue_pos, 0);
+		g_atomic_int_set (&_dequeue_pos, 0);
+	}
+
+	guint bufsize () const { return _buffer_mask + 1; }
+
+	/** Any thread: append an item.
+	 * @return false if the queue is full
+	 */
+	bool push_back (T const& data) {
+		cell_t* cell;
+		guint pos = g_atomic_int_get (&_enqueue_pos);
+		for (;;) {
+			cell = &_buffer[pos & _buffer_mask];
+			guint seq = g_atomic_int_get (&cell->_sequence);
+			gint dif = (gint)(seq - pos);
+			if (dif == 0) {
+				if (g_atomic_int_compare_and_exchange (&_enqueue_pos, (gint) pos, (gint) (pos + 1))) {
+					break;
+				}
+			} else if (dif < 0) {
+				/* full: the cell still holds an item of the previous lap */
+				return false;
+			} else {
+				/* another producer claimed the cell */
+				pos = g_atomic_int_get (&_enqueue_pos);
+			}
+		}
+		cell->_data = data;
+		g_atomic_int_set (&cell->_sequence, pos + 1);
+		return true;
+	}
+
+	/** Any thread: remove the oldest item.
+	 * @return false if the queue is empty
+	 */
+	bool pop_front (T& data) {
+		cell_t* cell;
+		guint pos = g_atomic_int_get (&_dequeue_pos);
+		for (;;) {
+			cell = &_buffer[pos & _buffer_mask];
+			guint seq = g_atomic_int_get (&cell->_sequence);
+			gint dif = (gint)(seq - (pos + 1));
+			if (dif == 0) {
+				if (g_atomic_int_compare_and_exchange (&_dequeue_pos, (gint) pos, (gint) (pos + 1))) {
+					break;
+				}
+			} else if (dif < 0) {
+				/* empty: the cell has not been written in this lap */
+				return false;
+			} else {
+				/* another consumer took the item */
+				pos = g_atomic_int_get (&_dequeue_pos);
+			}
+		}
+		data = cell->_data;
+		g_atomic_int_set (&cell->_sequence, pos + _buffer_mask + 1);
+		return true;
+	}
+
+  private:
+	struct cell_t {
+		mutable gint _sequence;
+		T            _data;
+	};
+
+	cell_t* _buffer;
+	guint   _buffer_mask;
+
+	/* keep producer and consumer positions on separate cache lines */
+	char _pad0[64];
+	mutable gint _enqueue_pos;
+	char _pad1[64];
+	mutable gint _dequeue_pos;
+	char _pad2[64];
+};
+
+} /* namespace */
+
+#endif /* __pbd_mpmc_queue_h__ */
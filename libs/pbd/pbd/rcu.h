@@ -27,6 +27,57 @@
 
 #include "pbd/libpbd_visibility.h"
 
+/** RCUEpoch implements quiescent-state based reclamation for
+   SerializedRCUManager::rt_reader().
+
+   Realtime code that reads through rt_reader() does so inside a read
+   section (RCUEpoch::ReadSection, usually one per process cycle). A value
+   that a writer replaced is only deleted once every thread that was inside
+   a read section at the time of the replacement has left it, so plain
+   pointers obtained in a read section remain valid until its end, without
+   any reference counting.
+
+   Sections that run concurrently on other threads as part of the same
+   cycle (graph or tasklist workers, which the cycle waits for) are covered
+   by the section of the thread that drives the cycle.
+*/
+class LIBPBD_API RCUEpoch
+{
+  public:
+	/** RT safe: enter a read section in the calling thread. Sections nest. */
+	static void enter ();
+	/** RT safe: leave a read section */
+	static void leave ();
+	/** @return true if the calling thread is inside a read section */
+	static bool in_read_section ();
+
+	/** start a new epoch. Values retired before this call may be
+	 * reclaimed once passed() is true for the returned epoch.
+	 */
+	static guint advance ();
+	/** @return true if no thread is in a read section that started before @a epoch */
+	static bool passed (guint epoch);
+
+	class ReadSection {
+	  public:
+		ReadSection () { RCUEpoch::enter (); }
+		~ReadSection () { RCUEpoch::leave (); }
+	};
+
+  private:
+	enum { max_threads = 64 };
+
+	static int  slot ();
+	static void release_slot (void*);
+
+	static gint _epoch;
+	static gint _overflow;
+	static gint _slot_used[max_threads];
+	static gint _slot_epoch[max_threads];
+	static int  _slot_depth[max_threads];
+	static Glib::Threads::Private<gint> _thread_slot;
+};
+
 /** @file Defines a set of classes to implement Read-Copy-Update.  We do not attempt to define RCU here - use google.
 
    The design consists of two parts: an RCUManager and an RCUWriter.
@@ -49,13 +100,23 @@ class /*LIBPBD_API*/ RCUManager
 {
   public:
 
-	RCUManager (T* new_rcu_value) {
+	RCUManager (T* new_rcu_value) : _active_reads (0) {
 		x.m_rcu_value = new boost::shared_ptr<T> (new_rcu_value);
 	}
 
 	virtual ~RCUManager() { delete x.m_rcu_value; }
 
-	boost::shared_ptr<T> reader () const { return *((boost::shared_ptr<T> *) g_atomic_pointer_get (&x.gptr)); }
+	boost::shared_ptr<T> reader () const {
+		boost::shared_ptr<T> rv;
+		/* Count readers that are copying the shared_ptr<T>, so that a
+		 * writer does not delete it (after swapping in a new one) while
+		 * the copy is being made.
+		 */
+		g_atomic_int_inc (&_active_reads);
+		rv = *((boost::shared_ptr<T> *) g_atomic_pointer_get (&x.gptr));
+		g_atomic_int_dec_and_test (&_active_reads);
+		return rv;
+	}
 
 	/* this is an abstract base class - how these are implemented depends on the assumptions
 	   that one can make about the users of the RCUManager. See SerializedRCUManager below
@@ -79,6 +140,8 @@ class /*LIBPBD_API*/ RCUManager
 	    boost::shared_ptr<T>* m_rcu_value;
 	    mutable volatile gpointer gptr;
 	} x;
+
+	mutable gint _active_reads;
 };
 
 
@@ -96,19 +159,24 @@ class /*LIBPBD_API*/ RCUManager
    undefined.
 
    The class maintains a lock-protected "dead wood" list of old value of
-   *m_rcu_value (i.e. shared_ptr<T>). The list is cleaned up every time we call
-   write_copy(). If the list is the last instance of a shared_ptr<T> that
-   references the object (determined by shared_ptr::unique()) then we
-   erase it from the list, thus deleting the object it points to.  This is lazy
-   destruction - the SerializedRCUManager assumes that there will sufficient
-   calls to write_copy() to ensure that we do not inadvertently leave objects
-   around for excessive periods of time.
+   *m_rcu_value (i.e. shared_ptr<T>), each tagged with the RCUEpoch in which
+   it was replaced. The list is cleaned up by update(), write_copy() and
+   reclaim(), none of which wait for realtime readers. If the list is the
+   last instance of a shared_ptr<T> that references the object (determined
+   by shared_ptr::unique()) and no rt_reader() can still see it, then we
+   erase it from the list, thus deleting the object it points to, always in
+   the writer's thread. Values still visible to a read section are left for
+   a later writer.
+
+   Realtime readers should use rt_reader() inside an RCUEpoch::ReadSection:
+   it returns a plain pointer and does not touch any reference count.
 
    For extremely well defined circumstances (i.e. it is known that there are no
    other writer objects in existence), SerializedRCUManager also provides a
-   flush() method that will unconditionally clear out the "dead wood" list. It
-   must be used with significant caution, although the use of shared_ptr<T>
-   means that no actual objects will be deleted incorrectly if this is misused.
+   flush() method that will clear out the "dead wood" list, except for values
+   that an rt_reader() may still see. It must be used with significant
+   caution, although the use of shared_ptr<T> means that no actual objects
+   will be deleted incorrectly if this is misused.
 */
 template<class T>
 class /*LIBPBD_API*/ SerializedRCUManager : public RCUManager<T>
@@ -117,24 +185,26 @@ public:
 
 	SerializedRCUManager(T* new_rcu_value)
 		: RCUManager<T>(new_rcu_value)
+		, m_rt_value (new_rcu_value)
 	{
 	}
 
+	/** RT safe: obtain a plain pointer to the current value, without
+	 * reference counting. Must only be called inside an
+	 * RCUEpoch::ReadSection, and the pointer must not be used after
+	 * leaving it.
+	 */
+	T* rt_reader () const {
+		return (T*) g_atomic_pointer_get (&m_rt_value);
+	}
+
 	boost::shared_ptr<T> write_copy ()
 	{
 		m_lock.lock();
 
 		// clean out any dead wood
 
-		typename std::list<boost::shared_ptr<T> >::iterator i;
-
-		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
-			if ((*i).unique()) {
-				i = m_dead_wood.erase (i);
-			} else {
-				++i;
-			}
-		}
+		reclaim_locked ();
 
 		/* store the current so that we can do compare and exchange
 		   when someone calls update(). Notice that we hold
@@ -170,15 +240,32 @@ public:
 
 		if (ret) {
 
+			g_atomic_pointer_set (&m_rt_value, new_value.get ());
+
 			// successful update : put the old value into dead_wood,
 
-			m_dead_wood.push_back (*current_write_old);
+			guint epoch = RCUEpoch::advance ();
+			m_dead_wood.push_back (DeadWood (*current_write_old, epoch));
+
+			// readers that loaded the old pointer before the exchange
+			// may still be copying the shared_ptr<T>; wait for them.
+			// This is short: reader() only copies a shared_ptr.
+
+			while (g_atomic_int_get (&(RCUManager<T>::_active_reads)) != 0) {
+				/* spin */
+			}
 
 			// now delete it - this gets rid of the shared_ptr<T> but
 			// because dead_wood contains another shared_ptr<T> that
 			// references the same T, the underlying object lives on
 
 			delete current_write_old;
+
+			// if no realtime reader can see the old value, it
+			// can go right away (unless a reader() holds it),
+			// otherwise it is left for a later writer.
+
+			reclaim_locked ();
 		}
 
 		/* unlock, allowing other writers to proceed */
@@ -188,15 +275,48 @@ public:
 		return ret;
 	}
 
+	/** Non RT: delete old values that are no longer referenced */
+	void reclaim () {
+		Glib::Threads::Mutex::Lock lm (m_lock);
+		reclaim_locked ();
+	}
+
 	void flush () {
 		Glib::Threads::Mutex::Lock lm (m_lock);
-		m_dead_wood.clear ();
+		typename std::list<DeadWood>::iterator i;
+
+		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
+			if (RCUEpoch::passed (i->epoch)) {
+				i = m_dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
 	}
 
 private:
-	Glib::Threads::Mutex                      m_lock;
+	struct DeadWood {
+		DeadWood (boost::shared_ptr<T> const& v, guint e) : value (v), epoch (e) {}
+		boost::shared_ptr<T> value;
+		guint                epoch;
+	};
+
+	void reclaim_locked () {
+		typename std::list<DeadWood>::iterator i;
+
+		for (i = m_dead_wood.begin(); i != m_dead_wood.end(); ) {
+			if (i->value.unique() && RCUEpoch::passed (i->epoch)) {
+				i = m_dead_wood.erase (i);
+			} else {
+				++i;
+			}
+		}
+	}
+
+	Glib::Threads::Mutex             m_lock;
 	boost::shared_ptr<T>*            current_write_old;
-	std::list<boost::shared_ptr<T> > m_dead_wood;
+	mutable volatile gpointer        m_rt_value;
+	std::list<DeadWood>              m_dead_wood;
 };
 
 /** RCUWriter is a convenience object that implements write_copy/update via
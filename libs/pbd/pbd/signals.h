@@ -29,6 +29,7 @@
 #undef nil
 #endif
 
+#include <glib.h>
 #include <glibmm/threads.h>
 
 #include <boost/noncopyable.hpp>
@@ -40,6 +41,7 @@
 
 #include "pbd/libpbd_visibility.h"
 #include "pbd/event_loop.h"
+#include "pbd/rcu.h"
 
 #ifndef NDEBUG
 #define DEBUG_PBD_SIGNAL_CONNECTIONS
@@ -78,7 +80,7 @@ protected:
 class LIBPBD_API Connection : public boost::enable_shared_from_this<Connection>
 {
 public:
-	Connection (SignalBase* b, PBD::EventLoop::InvalidationRecord* ir) : _signal (b), _invalidation_record (ir)
+	Connection (SignalBase* b, PBD::EventLoop::InvalidationRecord* ir) : _signal (b), _invalidation_record (ir), _connected (1)
 	{
 		if (_invalidation_record) {
 			_invalidation_record->ref ();
@@ -96,6 +98,7 @@ public:
 
 	void disconnected ()
 	{
+		g_atomic_int_set (&_connected, 0);
 		if (_invalidation_record) {
 			_invalidation_record->unref ();
 		}
@@ -103,6 +106,7 @@ public:
 
 	void signal_going_away ()
 	{
+		g_atomic_int_set (&_connected, 0);
 		Glib::Threads::Mutex::Lock lm (_mutex);
 		if (_invalidation_record) {
 			_invalidation_record->unref ();
@@ -110,10 +114,14 @@ public:
 		_signal = 0;
 	}
 
+	/** lock-free check used by RTSignals while emitting */
+	bool connected () const { return g_atomic_int_get (&_connected); }
+
 private:
         Glib::Threads::Mutex _mutex;
 	SignalBase* _signal;
 	PBD::EventLoop::InvalidationRecord* _invalidation_record;
+	mutable gint _connected;
 };
 
 template<typename R>
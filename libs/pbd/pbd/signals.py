@@ -46,11 +46,18 @@ def comma_separated(n, prefix = ""):
         r += "%s%s" % (prefix, n[i])
     return r
 
-# Generate one SignalN class definition
+# Generate one SignalN (or RTSignalN) class definition
 # @param f File to write to
 # @param n Number of parameters
 # @param v True to specialize the template for a void return type
-def signal(f, n, v):
+# @param rt True to generate RTSignalN, whose slot list is managed by RCU
+#           so that emission does not take a lock
+def signal(f, n, v, rt = False):
+
+    if rt:
+        name = "RTSignal%d" % n
+    else:
+        name = "Signal%d" % n
 
     # The parameters in the form A1, A2, A3, ...
     An = []
@@ -75,16 +82,20 @@ def signal(f, n, v):
     else:
         typename = "typename "
 
+    if rt:
+        kind = "An RT signal"
+    else:
+        kind = "A signal"
     if v:
-        print("/** A signal with %d parameters (specialisation for a void return) */" % n, file=f)
+        print("/** %s with %d parameters (specialisation for a void return) */" % (kind, n), file=f)
     else:
-        print("/** A signal with %d parameters */" % n, file=f)
+        print("/** %s with %d parameters */" % (kind, n), file=f)
     if v:
         print("template <%s>" % comma_separated(An, "typename "), file=f)
-        print("class Signal%d<%s> : public SignalBase" % (n, comma_separated(["void"] + An)), file=f)
+        print("class %s<%s> : public SignalBase" % (name, comma_separated(["void"] + An)), file=f)
     else:
         print("template <%s>" % comma_separated(["R"] + An + ["C = OptionalLastValue<R> "], "typename "), file=f)
-        print("class Signal%d : public SignalBase" % n, file=f)
+        print("class %s : public SignalBase" % name, file=f)
 
     print("{", file=f)
     print("public:", file=f)
@@ -102,17 +113,28 @@ def signal(f, n, v):
 
     print("""
 	/** The slots that this signal will call on emission */
-	typedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;
-	Slots _slots;
-""", file=f)
+	typedef std::map<boost::shared_ptr<Connection>, slot_function_type> Slots;""", file=f)
+    if rt:
+        print("\tSerializedRCUManager<Slots> _slots;", file=f)
+    else:
+        print("\tSlots _slots;", file=f)
+    print("", file=f)
 
     print("public:", file=f)
     print("", file=f)
-    print("\t~Signal%d () {" % n, file=f)
-
-    print("\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
-    print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
-    print("\t\tfor (%sSlots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {" % typename, file=f)
+    if rt:
+        print("\t%s () : _slots (new Slots) {}" % name, file=f)
+        print("", file=f)
+    print("\t~%s () {" % name, file=f)
+
+    if rt:
+        print("\t\tboost::shared_ptr<Slots> s = _slots.reader ();", file=f)
+        print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
+        print("\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
+    else:
+        print("\t\tGlib::Threads::Mutex::Lock lm (_mutex);", file=f)
+        print("\t\t/* Tell our connection objects that we are going away, so they don't try to call us */", file=f)
+        print("\t\tfor (%sSlots::const_iterator i = _slots.begin(); i != _slots.end(); ++i) {" % typename, file=f)
 
     print("\t\t\ti->first->signal_going_away ();", file=f)
     print("\t\t}", file=f)
@@ -224,6 +246,13 @@ def signal(f, n, v):
 	    the precise execution time of cross-thread slots).
 	*/
 """, file=f)
+    if rt:
+        rt_signal_body(f, n, v, typename, Anan, an)
+    else:
+        signal_body(f, n, v, typename, Anan, an)
+
+# Emission and connection management of SignalN, the slot list is protected by a mutex
+def signal_body(f, n, v, typename, Anan, an):
 
     if v:
         print("\tvoid operator() (%s)" % comma_separated(Anan), file=f)
@@ -280,11 +309,6 @@ def signal(f, n, v):
 	}
 """, file=f)
 
-    if v:
-        tp = comma_separated(["void"] + An)
-    else:
-        tp = comma_separated(["R"] + An + ["C"])
-
     print("private:", file=f)
     print("", file=f)
     print("\tfriend class Connection;", file=f)
@@ -322,6 +346,97 @@ def signal(f, n, v):
 };    
 """, file=f)
 
+# Emission and connection management of RTSignalN.
+#
+# The slot list is replaced as a whole (read-copy-update) whenever a slot is
+# connected or disconnected, and emission iterates over the list that was
+# current when it started. Emitting does not take any lock and does not
+# allocate (slots that are executed in another event loop still queue a
+# request there), so it will not block behind a thread that (dis)connects.
+def rt_signal_body(f, n, v, typename, Anan, an):
+    if v:
+        print("\tvoid operator() (%s)" % comma_separated(Anan), file=f)
+    else:
+        print("\ttypename C::result_type operator() (%s)" % comma_separated(Anan), file=f)
+    print("\t{", file=f)
+    print("\t\tboost::shared_ptr<Slots> s = _slots.reader ();", file=f)
+    print("", file=f)
+    if not v:
+        print("\t\tstd::list<R> r;", file=f)
+    print("\t\tfor (%sSlots::const_iterator i = s->begin(); i != s->end(); ++i) {" % typename, file=f)
+    print("""
+			/* A slot that we called may have disconnected other
+			   slots from us. Their connection is marked before they
+			   are removed from the slot list.
+			*/
+			if (i->first->connected ()) {""", file=f)
+    if v:
+        print("\t\t\t\t(i->second)(%s);" % comma_separated(an), file=f)
+    else:
+        print("\t\t\t\tr.push_back ((i->second)(%s));" % comma_separated(an), file=f)
+    print("\t\t\t}", file=f)
+    print("\t\t}", file=f)
+    print("", file=f)
+    if not v:
+        print("\t\t/* Call our combiner to do whatever is required to the result values */", file=f)
+        print("\t\tC c;", file=f)
+        print("\t\treturn c (r.begin(), r.end());", file=f)
+    print("\t}", file=f)
+
+    print("""
+	bool empty () const {
+		return _slots.reader ()->empty ();
+	}
+""", file=f)
+    print("""
+	bool size () const {
+		return _slots.reader ()->size ();
+	}
+""", file=f)
+
+    print("private:", file=f)
+    print("", file=f)
+    print("\tfriend class Connection;", file=f)
+
+    print("""
+	boost::shared_ptr<Connection> _connect (PBD::EventLoop::InvalidationRecord* ir, slot_function_type f)
+	{
+		boost::shared_ptr<Connection> c (new Connection (this, ir));
+		{
+			RCUWriter<Slots> writer (_slots);
+			(*writer.get_copy ())[c] = f;
+		}
+#ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
+                if (_debug_connection) {
+                        std::cerr << "+++++++ CONNECT " << this << " size now " << _slots.reader ()->size() << std::endl;
+                        PBD::stacktrace (std::cerr, 10);
+                }
+#endif
+		return c;
+	}""", file=f)
+
+    print("""
+	void disconnect (boost::shared_ptr<Connection> c)
+	{
+		/* mark the connection first, so that a concurrent emission
+		   which still uses the old slot list skips it */
+		c->disconnected ();
+		{
+			RCUWriter<Slots> writer (_slots);
+			writer.get_copy ()->erase (c);
+		}
+#ifdef DEBUG_PBD_SIGNAL_CONNECTIONS
+               	if (_debug_connection) {
+    			std::cerr << "------- DISCCONNECT " << this << " size now " << _slots.reader ()->size() << std::endl;
+                        PBD::stacktrace (std::cerr, 10);
+		}
+#endif
+	}
+};
+""", file=f)
+
 for i in range(0, 6):
     signal(f, i, False)
     signal(f, i, True)
+    signal(f, i, False, True)
+    signal(f, i, True, True)
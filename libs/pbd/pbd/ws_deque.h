@@ -0,0 +1,137 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __pbd_ws_deque_h__
+#define __pbd_ws_deque_h__
+
+#include <glib.h>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** A fixed-size, lock-free work-stealing deque (Chase & Lev, 2005).
+ *
+ * The thread owning the deque may push() and pop() at the bottom end,
+ * any other thread may steal() from the top end. The deque never
+ * allocates after construction, push() fails if it is full.
+ *
+ * Indices are free-running unsigned integers; their difference is
+ * always evaluated as a signed value, so wrap-around is harmless.
+ */
+template<class T>
+class /*LIBPBD_API*/ WorkStealingDeque
+{
+  public:
+	WorkStealingDeque (guint sz) {
+		guint power_of_two;
+		for (power_of_two = 1; 1U<<power_of_two < sz; power_of_two++) {}
+		size = 1<<power_of_two;
+		size_mask = size - 1;
+		buf = new T[size];
+		reset ();
+	}
+
+	~WorkStealingDeque () {
+		delete [] buf;
+	}
+
+	void reset () {
+		/* !!! NOT THREAD SAFE !!! */
+		g_atomic_int_set (&top, 0);
+		g_atomic_int_set (&bottom, 0);
+	}
+
+	/** Owner only: add an item to the bottom end.
+	 * @return false if the deque is full
+	 */
+	bool push (T const& item) {
+		guint b = g_atomic_int_get (&bottom);
+		guint t = g_atomic_int_get (&top);
+		if ((gint)(b - t) >= (gint)size) {
+			return false;
+		}
+		buf[b & size_mask] = item;
+		g_atomic_int_set (&bottom, b + 1);
+		return true;
+	}
+
+	/** Owner only: remove the most recently pushed item.
+	 * @return false if the deque is empty, or the last item was stolen.
+	 */
+	bool pop (T& item) {
+		guint b = g_atomic_int_get (&bottom) - 1;
+		g_atomic_int_set (&bottom, b);
+		guint t = g_atomic_int_get (&top);
+		gint n = (gint)(b - t);
+
+		if (n < 0) {
+			/* empty */
+			g_atomic_int_set (&bottom, t);
+			return false;
+		}
+
+		item = buf[b & size_mask];
+
+		if (n > 0) {
+			/* more than one item left, no race with thieves */
+			return true;
+		}
+
+		/* last item: race against concurrent steal() */
+		bool rv = g_atomic_int_compare_and_exchange (&top, (gint) t, (gint) (t + 1));
+		g_atomic_int_set (&bottom, t + 1);
+		return rv;
+	}
+
+	/** Any thread: remove the oldest item from the top end.
+	 * @return false if the deque is empty, or another thread won the race
+	 */
+	bool steal (T& item) {
+		guint t = g_atomic_int_get (&top);
+		guint b = g_atomic_int_get (&bottom);
+
+		if ((gint)(b - t) <= 0) {
+			return false;
+		}
+
+		item = buf[t & size_mask];
+		return g_atomic_int_compare_and_exchange (&top, (gint) t, (gint) (t + 1));
+	}
+
+	/** approximate number of queued items, may be stale by the time it returns */
+	guint read_space () const {
+		gint n = (gint)((guint) g_atomic_int_get (&bottom) - (guint) g_atomic_int_get (&top));
+		return n > 0 ? n : 0;
+	}
+
+	bool empty () const { return read_space () == 0; }
+	guint bufsize () const { return size; }
+
+  private:
+	T*    buf;
+	guint size;
+	guint size_mask;
+	mutable gint top;
+	mutable gint bottom;
+};
+
+} /* namespace */
+
+#endif /* __pbd_ws_deque_h__ */
@@ -95,6 +95,17 @@ public:
 
 	const std::string& write_buffer() const;
 
+	/** Write the tree in a compact binary form which loads much faster
+	 * than XML. The file is versioned and tagged with @a stamp, so that
+	 * callers can detect when it no longer matches its XML counterpart.
+	 */
+	bool write_binary(const std::string& fn, const std::string& stamp) const;
+	/** Read a tree written by write_binary(). Fails if the file is
+	 * missing, damaged, of another version or byte order, or if it was
+	 * written with a stamp other than @a stamp.
+	 */
+	bool read_binary(const std::string& fn, const std::string& stamp);
+
 	boost::shared_ptr<XMLSharedNodeList> find(const std::string xpath, XMLNode* = 0) const;
 
 private:
@@ -102,7 +113,7 @@ private:
 
 	std::string _filename;
 	XMLNode*    _root;
-	xmlDocPtr   _doc;
+	mutable xmlDocPtr _doc;
 	int         _compression;
 };
 
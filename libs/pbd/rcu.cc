@@ -0,0 +1,147 @@
+/*
+    Copyright (C) 2019 Paul Davis
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include <glib.h>
+
+#include "pbd/rcu.h"
+
+/* epoch 0 marks a slot whose thread is not in a read section */
+gint RCUEpoch::_epoch = 1;
+gint RCUEpoch::_overflow = 0;
+gint RCUEpoch::_slot_used[RCUEpoch::max_threads];
+gint RCUEpoch::_slot_epoch[RCUEpoch::max_threads];
+int  RCUEpoch::_slot_depth[RCUEpoch::max_threads];
+Glib::Threads::Private<gint> RCUEpoch::_thread_slot (&RCUEpoch::release_slot);
+
+/* the thread's slot is kept in thread-local storage as (slot + 1),
+ * -1 if all slots were taken when the thread first entered a section.
+ */
+
+void
+RCUEpoch::release_slot (void* p)
+{
+	int s = GPOINTER_TO_INT (p) - 1;
+	if (s >= 0) {
+		g_atomic_int_set (&_slot_epoch[s], 0);
+		_slot_depth[s] = 0;
+		g_atomic_int_set (&_slot_used[s], 0);
+	}
+}
+
+int
+RCUEpoch::slot ()
+{
+	gint* p = _thread_slot.get ();
+	if (p) {
+		return GPOINTER_TO_INT (p) - 1;
+	}
+
+	/* first use in this thread: claim a free slot (no allocation) */
+	int s = -2;
+	for (int i = 0; i < max_threads; ++i) {
+		if (g_atomic_int_compare_and_exchange (&_slot_used[i], 0, 1)) {
+			s = i;
+			break;
+		}
+	}
+	_thread_slot.set ((gint*) GINT_TO_POINTER (s + 1));
+	return s;
+}
+
+void
+RCUEpoch::enter ()
+{
+	int s = slot ();
+
+	if (s < 0) {
+		/* no slot: writers conservatively wait for all of these */
+		g_atomic_int_inc (&_overflow);
+		return;
+	}
+
+	if (_slot_depth[s]++ > 0) {
+		return;
+	}
+
+	guint e = g_atomic_int_get (&_epoch);
+	if (e == 0) {
+		/* advance() is just wrapping around: pretend to be the oldest reader */
+		e = (guint) -1;
+	}
+	g_atomic_int_set (&_slot_epoch[s], e);
+}
+
+void
+RCUEpoch::leave ()
+{
+	int s = slot ();
+
+	if (s < 0) {
+		g_atomic_int_dec_and_test (&_overflow);
+		return;
+	}
+
+	if (--_slot_depth[s] > 0) {
+		return;
+	}
+
+	g_atomic_int_set (&_slot_epoch[s], 0);
+}
+
+bool
+RCUEpoch::in_read_section ()
+{
+	gint* p = _thread_slot.get ();
+	if (!p) {
+		return false;
+	}
+	int s = GPOINTER_TO_INT (p) - 1;
+	if (s < 0) {
+		/* unknown, assume so: the caller must not wait for readers */
+		return true;
+	}
+	return _slot_depth[s] > 0;
+}
+
+guint
+RCUEpoch::advance ()
+{
+	guint e = g_atomic_int_add (&_epoch, 1) + 1;
+	if (e == 0) {
+		e = g_atomic_int_add (&_epoch, 1) + 1;
+	}
+	return e;
+}
+
+bool
+RCUEpoch::passed (guint epoch)
+{
+	if (g_atomic_int_get (&_overflow) > 0) {
+		return false;
+	}
+
+	for (int i = 0; i < max_threads; ++i) {
+		guint e = g_atomic_int_get (&_slot_epoch[i]);
+		if (e != 0 && (gint)(e - epoch) < 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
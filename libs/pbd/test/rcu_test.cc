@@ -0,0 +1,118 @@
+#include <glib.h>
+
+#include "pbd/rcu.h"
+
+#include "rcu_test.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (RCUTest);
+
+using namespace std;
+
+struct Counted {
+	Counted (int v = 0) : value (v) {}
+	Counted (Counted const& other) : value (other.value) {}
+	~Counted () { g_atomic_int_inc (&destroyed); }
+
+	int value;
+	static gint destroyed;
+};
+
+gint Counted::destroyed = 0;
+
+void
+RCUTest::testRTReader ()
+{
+	SerializedRCUManager<Counted> m (new Counted (1));
+
+	{
+		RCUEpoch::ReadSection rs;
+		CPPUNIT_ASSERT (RCUEpoch::in_read_section ());
+		CPPUNIT_ASSERT_EQUAL (1, m.rt_reader ()->value);
+	}
+
+	CPPUNIT_ASSERT (!RCUEpoch::in_read_section ());
+
+	{
+		RCUWriter<Counted> w (m);
+		w.get_copy ()->value = 2;
+	}
+
+	RCUEpoch::ReadSection rs;
+	CPPUNIT_ASSERT_EQUAL (2, m.rt_reader ()->value);
+	CPPUNIT_ASSERT_EQUAL (2, m.reader ()->value);
+}
+
+void
+RCUTest::testReclaim ()
+{
+	SerializedRCUManager<Counted> m (new Counted (1));
+	g_atomic_int_set (&Counted::destroyed, 0);
+
+	/* no readers: the old value goes away with the update */
+	{
+		RCUWriter<Counted> w (m);
+		w.get_copy ()->value = 2;
+	}
+	CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&Counted::destroyed));
+
+	/* a reference held by a reader() keeps it alive */
+	boost::shared_ptr<Counted> held = m.reader ();
+	{
+		RCUWriter<Counted> w (m);
+		w.get_copy ()->value = 3;
+	}
+	CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&Counted::destroyed));
+	CPPUNIT_ASSERT_EQUAL (2, held->value);
+
+	held.reset ();
+	m.reclaim ();
+	CPPUNIT_ASSERT_EQUAL (2, g_atomic_int_get (&Counted::destroyed));
+}
+
+struct SectionThread {
+	SectionThread (SerializedRCUManager<Counted>& m) : mgr (m), value (0), state (0) {}
+
+	void run () {
+		RCUEpoch::ReadSection rs;
+		Counted* c = mgr.rt_reader ();
+		g_atomic_int_set (&state, 1);
+		while (g_atomic_int_get (&state) != 2) {
+			g_usleep (1000);
+		}
+		/* still valid, even though it was replaced meanwhile */
+		value = c->value;
+	}
+
+	SerializedRCUManager<Counted>& mgr;
+	int value;
+	gint state;
+};
+
+void
+RCUTest::testReadSection ()
+{
+	SerializedRCUManager<Counted> m (new Counted (1));
+	g_atomic_int_set (&Counted::destroyed, 0);
+
+	SectionThread st (m);
+	Glib::Threads::Thread* t = Glib::Threads::Thread::create (sigc::mem_fun (st, &SectionThread::run));
+
+	while (g_atomic_int_get (&st.state) != 1) {
+		g_usleep (1000);
+	}
+
+	{
+		/* update() does not wait for the section */
+		RCUWriter<Counted> w (m);
+		w.get_copy ()->value = 2;
+	}
+	CPPUNIT_ASSERT_EQUAL (0, g_atomic_int_get (&Counted::destroyed));
+
+	g_atomic_int_set (&st.state, 2);
+	t->join ();
+
+	CPPUNIT_ASSERT_EQUAL (1, st.value);
+
+	m.reclaim ();
+	CPPUNIT_ASSERT_EQUAL (1, g_atomic_int_get (&Counted::destroyed));
+}
@@ -0,0 +1,16 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class RCUTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (RCUTest);
+	CPPUNIT_TEST (testRTReader);
+	CPPUNIT_TEST (testReclaim);
+	CPPUNIT_TEST (testReadSection);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	void testRTReader ();
+	void testReclaim ();
+	void testReadSection ();
+};
@@ -1,7 +1,9 @@
+#include <iostream>
 #include <glibmm/thread.h>
 
 #include "signals_test.h"
 #include "pbd/signals.h"
+#include "pbd/timing.h"
 
 using namespace std;
 
@@ -89,3 +91,110 @@ SignalsTest::testScopedConnectionList ()
 
 	CPPUNIT_ASSERT_EQUAL (1, N);
 }
+
+class RTEmitter {
+public:
+	void emit () {
+		Fred ();
+	}
+
+	PBD::RTSignal0<void> Fred;
+	PBD::RTSignal1<int, int> Doubled;
+};
+
+static int
+doubler (int x)
+{
+	return 2 * x;
+}
+
+void
+SignalsTest::testRTEmission ()
+{
+	RTEmitter* e = new RTEmitter;
+	PBD::ScopedConnection c;
+	e->Fred.connect_same_thread (c, boost::bind (&receiver));
+
+	N = 0;
+	e->emit ();
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (2, N);
+
+	{
+		PBD::ScopedConnection d;
+		e->Fred.connect_same_thread (d, boost::bind (&receiver));
+		N = 0;
+		e->emit ();
+		CPPUNIT_ASSERT_EQUAL (2, N);
+	}
+
+	N = 0;
+	e->emit ();
+	CPPUNIT_ASSERT_EQUAL (1, N);
+
+	PBD::ScopedConnection r;
+	e->Doubled.connect_same_thread (r, boost::bind (&doubler, _1));
+	CPPUNIT_ASSERT_EQUAL (42, *e->Doubled (21));
+
+	delete e;
+	c.disconnect ();
+	r.disconnect ();
+}
+
+/* connect and disconnect in one thread while another one emits */
+
+static volatile gint contention_quit;
+
+template<typename S>
+static void
+churn (S* s)
+{
+	while (!g_atomic_int_get (&contention_quit)) {
+		PBD::ScopedConnection c;
+		s->connect_same_thread (c, boost::bind (&receiver));
+	}
+}
+
+template<typename S>
+static double
+emit_with_contention (S& s, int n_emissions)
+{
+	PBD::ScopedConnection c;
+	s.connect_same_thread (c, boost::bind (&receiver));
+
+	g_atomic_int_set (&contention_quit, 0);
+	Glib::Threads::Thread* t = Glib::Threads::Thread::create (sigc::bind (sigc::ptr_fun (&churn<S>), &s));
+
+	PBD::TimingData timing;
+	timing.reserve (n_emissions);
+	for (int i = 0; i < n_emissions; ++i) {
+		timing.start_timing ();
+		s ();
+		timing.add_elapsed ();
+	}
+
+	g_atomic_int_set (&contention_quit, 1);
+	t->join ();
+
+	uint64_t min, max, avg, total;
+	timing.get_min_max_avg_total (min, max, avg, total);
+	return max;
+}
+
+void
+SignalsTest::testRTContention ()
+{
+	PBD::Signal0<void> locked;
+	PBD::RTSignal0<void> rt;
+
+	N = 0;
+	double const locked_max = emit_with_contention (locked, 100000);
+	CPPUNIT_ASSERT (N >= 100000);
+
+	N = 0;
+	double const rt_max = emit_with_contention (rt, 100000);
+	CPPUNIT_ASSERT (N >= 100000);
+
+	std::cerr << std::endl << "Signal0 emission, worst case with concurrent (dis)connection: "
+	          << locked_max << " us (locked), " << rt_max << " us (RT)" << std::endl;
+}
@@ -225,6 +225,7 @@ test_xml_document (const std::string& test_name,
 	const std::string output_file_basename = Glib::build_filename (test_output_dir, test_name);
 
 	TimingData create_timing_data, write_timing_data, read_timing_data;
+	TimingData write_binary_timing_data, read_binary_timing_data;
 
 	for (uint32_t iter = 0; iter < test_iterations; ++iter) {
 
@@ -258,14 +259,34 @@ test_xml_document (const std::string& test_name,
 		// check that what we have read is identical to what was written
 		CPPUNIT_ASSERT (*read_doc.root() == *test_xml.root());
 
+		const std::string binary_file_path = output_file_basename + buf + ".bin";
+
+		write_binary_timing_data.start_timing ();
+
+		CPPUNIT_ASSERT (test_xml.write_binary (binary_file_path, "stamp"));
+
+		write_binary_timing_data.add_elapsed ();
+
+		read_binary_timing_data.start_timing ();
+
+		XMLTree binary_doc;
+		CPPUNIT_ASSERT (binary_doc.read_binary (binary_file_path, "stamp"));
+
+		read_binary_timing_data.add_elapsed ();
+
+		CPPUNIT_ASSERT (*binary_doc.root() == *test_xml.root());
+
 		// These files are too big to keep around
 		CPPUNIT_ASSERT (g_remove (output_file_path.c_str ()) == 0);
+		CPPUNIT_ASSERT (g_remove (binary_file_path.c_str ()) == 0);
 	}
 
 	std::cerr << std::endl;
 	std::cerr << "   Create : " << create_timing_data.summary ();
 	std::cerr << "   Write : " << write_timing_data.summary ();
 	std::cerr << "   Read : " << read_timing_data.summary ();
+	std::cerr << "   Write binary : " << write_binary_timing_data.summary ();
+	std::cerr << "   Read binary : " << read_binary_timing_data.summary ();
 }
 
 void
@@ -304,3 +325,47 @@ XMLTest::testPerfLargeXMLDocument ()
 
 	test_xml_document ("testPerfLargeXMLDocument", node_options);
 }
+
+void
+XMLTest::testBinaryXMLDocument ()
+{
+	const string output_dir = test_output_directory ("BinaryXMLDocument");
+	const string path = Glib::build_filename (output_dir, "test.bin");
+
+	XMLTree tree;
+	XMLNode* root = tree.set_root (new XMLNode (root_node_name));
+	root->set_property ("name", "Test");
+	root->set_property ("empty", "");
+	XMLNode* child = root->add_child (child_node_name);
+	child->add_content ("1 0.5\n2 0.25\n");
+	root->add_child (child_node_name)->set_property ("name", "Test");
+
+	CPPUNIT_ASSERT (tree.write_binary (path, "1234:5678"));
+
+	XMLTree read;
+	CPPUNIT_ASSERT (read.read_binary (path, "1234:5678"));
+	CPPUNIT_ASSERT (*read.root () == *tree.root ());
+
+	/* stale */
+	XMLTree stale;
+	CPPUNIT_ASSERT (!stale.read_binary (path, "1234:5679"));
+	CPPUNIT_ASSERT (!stale.root ());
+
+	/* damaged or truncated */
+	gchar* contents;
+	gsize length;
+	CPPUNIT_ASSERT (g_file_get_contents (path.c_str (), &contents, &length, NULL));
+
+	XMLTree damaged;
+	contents[length - 1] ^= 0x55;
+	CPPUNIT_ASSERT (g_file_set_contents (path.c_str (), contents, length, NULL));
+	CPPUNIT_ASSERT (!damaged.read_binary (path, "1234:5678"));
+
+	contents[length - 1] ^= 0x55;
+	CPPUNIT_ASSERT (g_file_set_contents (path.c_str (), contents, length - 4, NULL));
+	CPPUNIT_ASSERT (!damaged.read_binary (path, "1234:5678"));
+
+	g_free (contents);
+
+	CPPUNIT_ASSERT (!damaged.read_binary (path + ".missing", "1234:5678"));
+}
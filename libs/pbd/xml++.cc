@@ -6,11 +6,16 @@
  */
 
 #include <iostream>
+#include <map>
+#include <cstring>
+
+#include <glib.h>
 
 #include "pbd/stacktrace.h"
 #include "pbd/xml++.h"
 
 #include <libxml/debugXML.h>
+#include <libxml/xmlreader.h>
 #include <libxml/xpath.h>
 #include <libxml/xpathInternals.h>
 
@@ -19,6 +24,7 @@ xmlChar* xml_version = xmlCharStrdup("1.0");
 using namespace std;
 
 static XMLNode*           readnode(xmlNodePtr);
+static XMLNode*           readtree(xmlTextReaderPtr);
 static void               writenode(xmlDocPtr, XMLNode*, xmlNodePtr, int);
 static XMLSharedNodeList* find_impl(xmlXPathContext* ctxt, const string& xpath);
 
@@ -85,6 +91,19 @@ XMLTree::read_internal(bool validate)
 		_doc = 0;
 	}
 
+	if (!validate) {
+		/* build the XMLNode tree directly while parsing, without an
+		 * intermediate libxml2 document. find() creates one if needed.
+		 */
+		xmlTextReaderPtr reader = xmlReaderForFile (_filename.c_str(), NULL, XML_PARSE_HUGE | XML_PARSE_NOBLANKS);
+		if (!reader) {
+			return false;
+		}
+		_root = readtree (reader);
+		xmlFreeTextReader (reader);
+		return _root != 0;
+	}
+
 	/* create a parser context */
 	xmlParserCtxtPtr ctxt = xmlNewParserCtxt();
 	if (ctxt == NULL) {
@@ -129,6 +148,16 @@ XMLTree::read_buffer(const string& buffer, bool to_tree_doc)
 	delete _root;
 	_root = 0;
 
+	if (!to_tree_doc) {
+		xmlTextReaderPtr reader = xmlReaderForMemory (buffer.c_str(), buffer.length(), NULL, NULL, XML_PARSE_HUGE | XML_PARSE_NOBLANKS);
+		if (!reader) {
+			return false;
+		}
+		_root = readtree (reader);
+		xmlFreeTextReader (reader);
+		return _root != 0;
+	}
+
 	doc = xmlParseMemory(const_cast<char*>(buffer.c_str()), buffer.length());
 	if (!doc) {
 		return false;
@@ -222,6 +251,286 @@ XMLTree::write_buffer() const
 	return retval;
 }
 
+/* Binary trees, see write_binary().
+ *
+ * The file starts with a BinaryHeader, followed by the stamp, a table
+ * of all distinct strings (names, values and content), and the nodes
+ * in pre-order: name, flags, [content], property count, (name, value)
+ * per property, child count. Integers are 32 bit in host byte order,
+ * strings are referenced by their index in the table.
+ */
+
+namespace {
+
+struct BinaryHeader {
+	char     magic[8];
+	uint32_t version;
+	uint32_t byte_order;
+	uint64_t size;      /* of the whole file */
+	uint32_t checksum;  /* of everything after the header */
+	uint32_t n_strings;
+	uint32_t n_nodes;
+	uint32_t reserved;
+};
+
+const char     binary_magic[8]   = { 'P', 'B', 'D', 'X', 'M', 'L', 'B', '\n' };
+const uint32_t binary_version    = 1;
+const uint32_t binary_byte_order = 0x01020304;
+const uint32_t binary_content    = 0x1;
+const int      binary_max_depth  = 1024;
+
+uint32_t
+binary_checksum (const char* p, size_t len)
+{
+	/* FNV-1a */
+	uint32_t h = 2166136261U;
+	for (size_t i = 0; i < len; ++i) {
+		h = (h ^ (uint8_t) p[i]) * 16777619U;
+	}
+	return h;
+}
+
+class BinaryWriter
+{
+  public:
+	BinaryWriter () : n_nodes (0) {}
+
+	void node (const XMLNode& n) {
+		++n_nodes;
+		put (nodes, intern (n.name ()));
+		put (nodes, n.is_content () ? binary_content : 0);
+		if (n.is_content ()) {
+			put (nodes, intern (n.content ()));
+		}
+
+		const XMLPropertyList& props (n.properties ());
+		put (nodes, props.size ());
+		for (XMLPropertyConstIterator i = props.begin (); i != props.end (); ++i) {
+			put (nodes, intern ((*i)->name ()));
+			put (nodes, intern ((*i)->value ()));
+		}
+
+		const XMLNodeList& children (n.children ());
+		put (nodes, children.size ());
+		for (XMLNodeConstIterator i = children.begin (); i != children.end (); ++i) {
+			node (**i);
+		}
+	}
+
+	static void put (string& buf, uint32_t v) {
+		buf.append ((const char*) &v, sizeof (v));
+	}
+
+	static void put (string& buf, const string& str) {
+		put (buf, str.length ());
+		buf.append (str);
+	}
+
+	vector<const string*> strings;
+	string                nodes;
+	uint32_t              n_nodes;
+
+  private:
+	uint32_t intern (const string& str) {
+		map<string, uint32_t>::iterator i = index.find (str);
+		if (i != index.end ()) {
+			return i->second;
+		}
+		i = index.insert (make_pair (str, (uint32_t) strings.size ())).first;
+		strings.push_back (&i->first);
+		return i->second;
+	}
+
+	map<string, uint32_t> index;
+};
+
+class BinaryReader
+{
+  public:
+	BinaryReader (const char* p, const char* end) : n_nodes (0), _p (p), _end (end) {}
+
+	bool get (uint32_t& v) {
+		if (_end - _p < (ptrdiff_t) sizeof (v)) {
+			return false;
+		}
+		memcpy (&v, _p, sizeof (v));
+		_p += sizeof (v);
+		return true;
+	}
+
+	bool get (string& str) {
+		uint32_t len;
+		if (!get (len) || (size_t) (_end - _p) < len) {
+			return false;
+		}
+		str.assign (_p, len);
+		_p += len;
+		return true;
+	}
+
+	bool strings (uint32_t n) {
+		if (n > (size_t) (_end - _p) / sizeof (uint32_t)) {
+			return false;
+		}
+		_strings.resize (n);
+		for (uint32_t i = 0; i < n; ++i) {
+			if (!get (_strings[i])) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* @return the node, or 0 if the data is malformed */
+	XMLNode* node (int depth) {
+		uint32_t name, flags, content, n;
+
+		if (depth > binary_max_depth || !get_string (name) || !get (flags)) {
+			return 0;
+		}
+
+		XMLNode* node;
+		++n_nodes;
+
+		if (flags & binary_content) {
+			if (!get_string (content)) {
+				return 0;
+			}
+			node = new XMLNode (_strings[name], _strings[content]);
+		} else {
+			node = new XMLNode (_strings[name]);
+		}
+
+		if (!get (n)) {
+			delete node;
+			return 0;
+		}
+		for (uint32_t i = 0; i < n; ++i) {
+			uint32_t pname, pvalue;
+			if (!get_string (pname) || !get_string (pvalue)) {
+				delete node;
+				return 0;
+			}
+			node->set_property (_strings[pname].c_str (), _strings[pvalue]);
+		}
+
+		if (!get (n)) {
+			delete node;
+			return 0;
+		}
+		for (uint32_t i = 0; i < n; ++i) {
+			XMLNode* child = this->node (depth + 1);
+			if (!child) {
+				delete node;
+				return 0;
+			}
+			node->add_child_nocopy (*child);
+		}
+
+		return node;
+	}
+
+	bool at_end () const { return _p == _end; }
+
+	uint32_t n_nodes;
+
+  private:
+	bool get_string (uint32_t& idx) {
+		return get (idx) && idx < _strings.size ();
+	}
+
+	const char*    _p;
+	const char*    _end;
+	vector<string> _strings;
+};
+
+} /* anonymous namespace */
+
+bool
+XMLTree::write_binary (const string& fn, const string& stamp) const
+{
+	if (!_root) {
+		return false;
+	}
+
+	BinaryWriter w;
+	w.node (*_root);
+
+	string buf (sizeof (BinaryHeader), '\0');
+	BinaryWriter::put (buf, stamp);
+	for (vector<const string*>::const_iterator i = w.strings.begin (); i != w.strings.end (); ++i) {
+		BinaryWriter::put (buf, **i);
+	}
+	buf.append (w.nodes);
+
+	BinaryHeader h;
+	memset (&h, 0, sizeof (h));
+	memcpy (h.magic, binary_magic, sizeof (h.magic));
+	h.version    = binary_version;
+	h.byte_order = binary_byte_order;
+	h.size       = buf.length ();
+	h.checksum   = binary_checksum (buf.data () + sizeof (h), buf.length () - sizeof (h));
+	h.n_strings  = w.strings.size ();
+	h.n_nodes    = w.n_nodes;
+	memcpy (&buf[0], &h, sizeof (h));
+
+	/* writes a temporary file and renames it */
+	return g_file_set_contents (fn.c_str (), buf.data (), buf.length (), NULL);
+}
+
+bool
+XMLTree::read_binary (const string& fn, const string& stamp)
+{
+	GMappedFile* file = g_mapped_file_new (fn.c_str (), FALSE, NULL);
+	if (!file) {
+		return false;
+	}
+
+	const char* data = g_mapped_file_get_contents (file);
+	const size_t len = g_mapped_file_get_length (file);
+	XMLNode*     root = 0;
+	BinaryHeader h;
+
+	if (len >= sizeof (h)) {
+		memcpy (&h, data, sizeof (h));
+	}
+
+	if (len >= sizeof (h)
+	    && !memcmp (h.magic, binary_magic, sizeof (h.magic))
+	    && h.version == binary_version
+	    && h.byte_order == binary_byte_order
+	    && h.size == len
+	    && h.checksum == binary_checksum (data + sizeof (h), len - sizeof (h))) {
+
+		BinaryReader r (data + sizeof (h), data + len);
+		string       file_stamp;
+
+		if (r.get (file_stamp) && file_stamp == stamp && r.strings (h.n_strings)) {
+			root = r.node (0);
+			if (root && (!r.at_end () || r.n_nodes != h.n_nodes)) {
+				delete root;
+				root = 0;
+			}
+		}
+	}
+
+	g_mapped_file_unref (file);
+
+	if (!root) {
+		return false;
+	}
+
+	delete _root;
+	_root = root;
+
+	if (_doc) {
+		xmlFreeDoc (_doc);
+		_doc = 0;
+	}
+
+	return true;
+}
+
 static const int PROPERTY_RESERVE_COUNT = 16;
 
 XMLNode::XMLNode(const string& n)
@@ -448,6 +757,11 @@ XMLTree::find(const string xpath, XMLNode* node) const
 		writenode(doc, node, doc->children, 1);
 		ctxt = xmlXPathNewContext(doc);
 	} else {
+		if (!_doc && _root) {
+			/* the tree was read without keeping the document */
+			_doc = xmlNewDoc(xml_version);
+			writenode(_doc, _root, _doc->children, 1);
+		}
 		ctxt = xmlXPathNewContext(_doc);
 	}
 
@@ -725,6 +1039,73 @@ readnode(xmlNodePtr node)
 	return tmp;
 }
 
+/** Build a tree of XMLNodes from a streaming parser, equivalent to
+ * readnode (xmlDocGetRootElement (doc)) of the parsed document.
+ * @return the root node, or 0 if the document is malformed
+ */
+static XMLNode*
+readtree(xmlTextReaderPtr reader)
+{
+	XMLNode* root = 0;
+	vector<XMLNode*> parents;
+	int ret;
+
+	while ((ret = xmlTextReaderRead (reader)) == 1) {
+
+		XMLNode* node;
+
+		switch (xmlTextReaderNodeType (reader)) {
+		case XML_READER_TYPE_ELEMENT:
+			node = new XMLNode ((const char*) xmlTextReaderConstLocalName (reader));
+			while (xmlTextReaderMoveToNextAttribute (reader) == 1) {
+				if (xmlTextReaderIsNamespaceDecl (reader)) {
+					continue;
+				}
+				node->set_property ((const char*) xmlTextReaderConstLocalName (reader),
+				                    string ((const char*) xmlTextReaderConstValue (reader)));
+			}
+			xmlTextReaderMoveToElement (reader);
+			break;
+		case XML_READER_TYPE_END_ELEMENT:
+			parents.pop_back ();
+			continue;
+		case XML_READER_TYPE_TEXT:
+		case XML_READER_TYPE_CDATA:
+			node = new XMLNode ("text", (const char*) xmlTextReaderConstValue (reader));
+			break;
+		case XML_READER_TYPE_COMMENT:
+			node = new XMLNode ("comment", (const char*) xmlTextReaderConstValue (reader));
+			break;
+		default:
+			/* whitespace, processing instructions, DTD */
+			continue;
+		}
+
+		if (!parents.empty ()) {
+			parents.back ()->add_child_nocopy (*node);
+		} else if (!root && !node->is_content ()) {
+			root = node;
+		} else {
+			/* top-level comment, outside the root element */
+			delete node;
+			continue;
+		}
+
+		if (node->is_content () || xmlTextReaderIsEmptyElement (reader)) {
+			continue;
+		}
+
+		parents.push_back (node);
+	}
+
+	if (ret != 0) {
+		delete root;
+		return 0;
+	}
+
+	return root;
+}
+
 static void
 writenode(xmlDocPtr doc, XMLNode* n, xmlNodePtr p, int root = 0)
 {
@@ -732,15 +1113,13 @@ writenode(xmlDocPtr doc, XMLNode* n, xmlNodePtr p, int root = 0)
 
 	if (root) {
 		node = doc->children = xmlNewDocNode(doc, 0, (const xmlChar*) n->name().c_str(), 0);
+	} else if (n->is_content()) {
+		/* a real text node: re-typing an element leaks its name */
+		node = xmlAddChild(p, xmlNewDocTextLen(doc, (const xmlChar*)n->content().c_str(), n->content().length()));
 	} else {
 		node = xmlNewChild(p, 0, (const xmlChar*) n->name().c_str(), 0);
 	}
 
-	if (n->is_content()) {
-		node->type = XML_TEXT_NODE;
-		xmlNodeSetContentLen(node, (const xmlChar*)n->content().c_str(), n->content().length());
-	}
-
 	const XMLPropertyList& props = n->properties();
 
 	for (XMLPropertyConstIterator prop_iter = props.begin (); prop_iter != props.end ();
@@ -19,6 +19,7 @@
 
 */
 
+#include <algorithm>
 #include <cmath>
 
 #include <boost/scoped_array.hpp>
@@ -123,6 +124,11 @@ WaveView::init ()
 
 WaveView::~WaveView ()
 {
+	for (std::vector<boost::shared_ptr<WaveViewDrawRequest> >::const_iterator r = current_requests.begin ();
+	     r != current_requests.end (); ++r) {
+		cancel_draw_request (*r);
+	}
+
 #ifdef ENABLE_THREADED_WAVEFORM_RENDERING
 	WaveViewThreads::deinitialize ();
 #endif
@@ -233,16 +239,28 @@ WaveView::set_clip_level (double dB)
 }
 
 boost::shared_ptr<WaveViewDrawRequest>
-WaveView::create_draw_request (WaveViewProperties const& props) const
+WaveView::create_draw_request (WaveViewProperties const& props, int64_t tile_index) const
 {
 	assert (props.is_valid());
 
 	boost::shared_ptr<WaveViewDrawRequest> request (new WaveViewDrawRequest);
 
-	request->image = boost::shared_ptr<WaveViewImage> (new WaveViewImage (_region, props));
+	request->image = boost::shared_ptr<WaveViewImage> (new WaveViewImage (_region, props, tile_index));
 	return request;
 }
 
+int64_t
+WaveView::prefetch_tiles () const
+{
+	/* enough to scroll by half a canvas width without waiting for a
+	 * worker thread, and to have the next tile ready when playing with
+	 * the canvas following the playhead.
+	 */
+	double const half_canvas_width = _canvas->visible_area().width() / 2.0;
+
+	return std::max ((int64_t) 1, (int64_t) ceil (half_canvas_width / WaveViewProperties::tile_width ()));
+}
+
 void
 WaveView::prepare_for_render (Rect const& area) const
 {
@@ -271,17 +289,33 @@ WaveView::prepare_for_render (Rect const& area) const
 		return;
 	}
 
-	if (_image) {
-		if (_image->props.is_equivalent (required_props)) {
-			return;
-		} else {
-			// Image does not contain sample area required
-		}
+	int64_t first;
+	int64_t last;
+	int64_t region_first;
+	int64_t region_last;
+
+	required_props.tile_range (required_props.get_sample_start (), required_props.get_sample_end (), first, last);
+	required_props.tile_range (_props->region_start, _props->region_end, region_first, region_last);
+
+	/* visible tiles first, then those next to them, nearest first */
+	std::vector<int64_t> tiles;
+
+	for (int64_t t = first; t <= last; ++t) {
+		tiles.push_back (t);
 	}
 
-	boost::shared_ptr<WaveViewDrawRequest> request = create_draw_request (required_props);
+	int64_t const prefetch = prefetch_tiles ();
+
+	for (int64_t n = 1; n <= prefetch; ++n) {
+		if (last + n <= region_last) {
+			tiles.push_back (last + n);
+		}
+		if (first - n >= region_first) {
+			tiles.push_back (first - n);
+		}
+	}
 
-	queue_draw_request (request);
+	queue_draw_requests (*_props, tiles, true);
 }
 
 bool
@@ -331,38 +365,83 @@ WaveView::get_item_and_draw_rect_in_window_coords (Rect const& canvas_rect, Rect
 }
 
 void
-WaveView::queue_draw_request (boost::shared_ptr<WaveViewDrawRequest> const& request) const
+WaveView::queue_draw_requests (WaveViewProperties const& props, std::vector<int64_t> const& tiles,
+                               bool cancel_others) const
 {
 	// Don't enqueue any requests without a thread to dequeue them.
 	assert (WaveViewThreads::enabled());
 
-	if (!request || !request->is_valid()) {
-		return;
-	}
+	std::vector<boost::shared_ptr<WaveViewDrawRequest> > requests;
 
-	if (current_request) {
-		current_request->cancel ();
-	}
+	for (std::vector<int64_t>::const_iterator t = tiles.begin (); t != tiles.end (); ++t) {
 
-	boost::shared_ptr<WaveViewImage> cached_image =
-	    get_cache_group ()->lookup_image (request->image->props);
+		WaveViewProperties tile_props (props);
+		tile_props.set_tile (*t);
 
-	if (cached_image) {
-		// The image may not be finished at this point but that is fine, great in
-		// fact as it means it should only need to be drawn once.
-		request->image = cached_image;
-		current_request = request;
-	} else {
-		// now we can finally set an optimal image now that we are not using the
-		// properties for comparisons.
-		request->image->props.set_width_samples (optimal_image_width_samples ());
+		if (tile_props.get_length_samples () == 0 || !tile_props.is_valid ()) {
+			continue;
+		}
 
-		current_request = request;
+		boost::shared_ptr<WaveViewDrawRequest> request;
+
+		for (std::vector<boost::shared_ptr<WaveViewDrawRequest> >::const_iterator r = current_requests.begin ();
+		     r != current_requests.end (); ++r) {
+			if ((*r)->image->tile == *t && (*r)->image->props.is_equivalent (tile_props)) {
+				request = *r;
+				break;
+			}
+		}
+
+		if (request) {
+			if (!request->finished ()) {
+				requests.push_back (request);
+			}
+			continue;
+		}
+
+		if (get_cache_group ()->lookup_image (tile_props, *t)) {
+			// The image may not be finished at this point but that is fine, it
+			// is being drawn for another WaveView showing the same source.
+			continue;
+		}
+
+		request = create_draw_request (tile_props, *t);
 
 		// Add it to the cache so that other WaveViews can refer to the same image
-		get_cache_group()->add_image (current_request->image);
+		get_cache_group ()->add_image (request->image);
+
+		WaveViewThreads::enqueue_draw_request (request);
 
-		WaveViewThreads::enqueue_draw_request (current_request);
+		requests.push_back (request);
+	}
+
+	for (std::vector<boost::shared_ptr<WaveViewDrawRequest> >::const_iterator r = current_requests.begin ();
+	     r != current_requests.end (); ++r) {
+		if (std::find (requests.begin (), requests.end (), *r) != requests.end ()) {
+			continue;
+		}
+		if (cancel_others) {
+			cancel_draw_request (*r);
+		} else if (!(*r)->finished ()) {
+			requests.push_back (*r);
+		}
+	}
+
+	current_requests.swap (requests);
+}
+
+void
+WaveView::cancel_draw_request (boost::shared_ptr<WaveViewDrawRequest> const& request) const
+{
+	if (request->finished ()) {
+		return;
+	}
+
+	request->cancel ();
+
+	/* other WaveViews must not wait for an image that is never drawn */
+	if (request->image->group) {
+		request->image->group->remove_image (request->image);
 	}
 }
 
@@ -848,80 +927,6 @@ WaveView::draw_image (Cairo::RefPtr<Cairo::ImageSurface>& image, PeakData* peaks
 	context->fill ();
 }
 
-samplecnt_t
-WaveView::optimal_image_width_samples () const
-{
-	/* Compute how wide the image should be in samples.
-	 *
-	 * The resulting image should be wider than the canvas width so that the
-	 * image does not have to be redrawn each time the canvas offset changes, but
-	 * drawing too much unnecessarily, for instance when zooming into the canvas
-	 * the part of the image that is outside of the visible canvas area may never
-	 * be displayed and will just increase apparent render time and reduce
-	 * responsiveness in non-threaded rendering and cause "flashing" waveforms in
-	 * threaded rendering mode.
-	 *
-	 * Another thing to consider is that if there are a number of waveforms on
-	 * the canvas that are the width of the canvas then we don't want to have to
-	 * draw the images for them all at once as it will cause a spike in render
-	 * time, or in threaded rendering mode it will mean all the draw requests will
-	 * the queued during the same sample/expose event. This issue can be
-	 * alleviated by using an element of randomness in selecting the image width.
-	 *
-	 * If the value of samples per pixel is less than 1/10th of a second, use
-	 * 1/10th of a second instead.
-	 */
-
-	samplecnt_t canvas_width_samples = _canvas->visible_area().width() * _props->samples_per_pixel;
-	const samplecnt_t one_tenth_of_second = _region->session().sample_rate() / 10;
-
-	/* If zoomed in where a canvas item interects with the canvas area but
-	 * stretches for many pages either side, to avoid having draw all images when
-	 * the canvas scrolls by a page width the multiplier would have to be a
-	 * randomized amount centered around 3 times the visible canvas width, but
-	 * for other operations like zooming or even with a stationary playhead it is
-	 * a lot of extra drawing that can affect performance.
-	 *
-	 * So without making things too complicated with different widths for
-	 * different operations, try to use a width that is a balance and will work
-	 * well for scrolling(non-page width) so all the images aren't redrawn at the
-	 * same time but also faster for sequential zooming operations.
-	 *
-	 * Canvas items that don't intersect with the edges of the visible canvas
-	 * will of course only draw images that are the pixel width of the item.
-	 *
-	 * It is a perhaps a coincidence that these values are centered roughly
-	 * around the golden ratio but they did work well in my testing.
-	 */
-	const double min_multiplier = 1.4;
-	const double max_multiplier = 1.8;
-
-	/**
-	 * A combination of high resolution screens, high samplerates and high
-	 * zoom levels(1 sample per pixel) can cause 1/10 of a second(in
-	 * pixels) to exceed the cairo image size limit.
-	 */
-	const double cairo_image_limit = 32767.0;
-	const double max_image_width = cairo_image_limit / max_multiplier;
-
-	samplecnt_t max_width_samples = floor (max_image_width / _props->samples_per_pixel);
-
-	const samplecnt_t one_tenth_of_second_limited = std::min (one_tenth_of_second, max_width_samples);
-
-	samplecnt_t new_sample_count = std::max (canvas_width_samples, one_tenth_of_second_limited);
-
-	const double multiplier = g_random_double_range (min_multiplier, max_multiplier);
-
-	return new_sample_count * multiplier;
-}
-
-void
-WaveView::set_image (boost::shared_ptr<WaveViewImage> img) const
-{
-	get_cache_group ()->add_image (img);
-	_image = img;
-}
-
 void
 WaveView::process_draw_request (boost::shared_ptr<WaveViewDrawRequest> req)
 {
@@ -1004,6 +1009,101 @@ WaveView::draw_image_in_gui_thread () const
 	       !WaveViewThreads::enabled ();
 }
 
+boost::shared_ptr<WaveViewImage>
+WaveView::get_image (WaveViewProperties const& props, int64_t tile_index) const
+{
+	for (std::vector<boost::shared_ptr<WaveViewImage> >::const_iterator i = _images.begin (); i != _images.end (); ++i) {
+		if ((*i)->tile == tile_index && (*i)->finished () && (*i)->props.is_equivalent (props)) {
+			return *i;
+		}
+	}
+
+	boost::shared_ptr<WaveViewImage> image = get_cache_group ()->lookup_image (props, tile_index);
+
+	if (image && image->finished ()) {
+		return image;
+	}
+
+	if (!draw_image_in_gui_thread () && _canvas->get_microseconds_since_render_start () >= 15000) {
+		// Leave it to a worker thread or a later render pass
+		return boost::shared_ptr<WaveViewImage> ();
+	}
+
+	// Drawing image in GUI thread as we have time
+
+	for (std::vector<boost::shared_ptr<WaveViewDrawRequest> >::iterator r = current_requests.begin ();
+	     r != current_requests.end (); ++r) {
+		if ((*r)->image->tile == tile_index && (*r)->image->props.is_equivalent (props)) {
+			cancel_draw_request (*r);
+			current_requests.erase (r);
+			break;
+		}
+	}
+
+	boost::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (props, tile_index);
+
+	process_draw_request (request);
+
+	if (!request->finished ()) {
+		return boost::shared_ptr<WaveViewImage> ();
+	}
+
+	get_cache_group ()->add_image (request->image);
+
+	return request->image;
+}
+
+void
+WaveView::draw_tile (Cairo::RefPtr<Cairo::Context> const& context, boost::shared_ptr<WaveViewImage> const& image,
+                     Rect const& self, Rect const& draw) const
+{
+	/* images drawn for another zoom level or height are scaled to fit */
+
+	double const xscale = image->props.samples_per_pixel / _props->samples_per_pixel;
+	double const yscale = _props->height / image->props.height;
+
+	double const image_origin_in_self_coordinates =
+	    (image->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel;
+
+	double x = self.x0 + image_origin_in_self_coordinates;
+	double y = self.y0;
+
+	if (xscale == 1.0 && yscale == 1.0) {
+		/* round image origin position to an exact pixel in device space to
+		 * avoid blurring
+		 */
+		context->user_to_device (x, y);
+		x = round (x);
+		y = round (y);
+		context->device_to_user (x, y);
+	}
+
+	double const x0 = max (draw.x0, x);
+	double const x1 = min (draw.x1, x + image->cairo_image->get_width () * xscale);
+
+	if (x1 <= x0) {
+		return;
+	}
+
+	context->save ();
+
+	context->rectangle (x0, draw.y0, x1 - x0, draw.height());
+	context->clip ();
+
+	/* the coordinates specify where in "user coordinates" (i.e. what we
+	 * generally call "canvas coordinates" in this code) the image origin
+	 * will appear. So specifying (10,10) will put the upper left corner of
+	 * the image at (10,10) in user space.
+	 */
+
+	context->translate (x, y);
+	context->scale (xscale, yscale);
+	context->set_source (image->cairo_image, 0, 0);
+	context->paint ();
+
+	context->restore ();
+}
+
 void
 WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) const
 {
@@ -1036,141 +1136,79 @@ WaveView::render (Rect const & area, Cairo::RefPtr<Cairo::Context> context) cons
 
 	assert (required_props.is_valid());
 
-	boost::shared_ptr<WaveViewImage> image_to_draw;
-
-	if (current_request) {
-		if (!current_request->image->props.is_equivalent (required_props)) {
-			// The WaveView properties may have been updated during recording between
-			// prepare_for_render and render calls and the new required props have
-			// different end sample value.
-			current_request->cancel ();
-			current_request.reset ();
-		} else if (current_request->finished ()) {
-			image_to_draw = current_request->image;
-			current_request.reset ();
-		}
-	} else {
-		// No current Request
-	}
-
-	if (!image_to_draw && _image) {
-		if (_image->props.is_equivalent (required_props)) {
-			// Image contains required properties
-			image_to_draw = _image;
-		} else {
-			// Image does not contain properties required
-		}
-	}
-
-	if (!image_to_draw) {
-		image_to_draw = get_cache_group ()->lookup_image (required_props);
-		if (image_to_draw && !image_to_draw->finished ()) {
-			// Found equivalent but unfinished Image in cache
-			image_to_draw.reset ();
-		}
-	}
-
-	if (!image_to_draw) {
-		// No existing image to draw
-
-		boost::shared_ptr<WaveViewDrawRequest> const request = create_draw_request (required_props);
+	int64_t first;
+	int64_t last;
 
-		if (draw_image_in_gui_thread ()) {
-			// now that we have to draw something, draw more than required.
-			request->image->props.set_width_samples (optimal_image_width_samples ());
+	required_props.tile_range (required_props.get_sample_start (), required_props.get_sample_end (), first, last);
 
-			process_draw_request (request);
+	std::vector<boost::shared_ptr<WaveViewImage> > images;
+	std::vector<int64_t> missing;
 
-			image_to_draw = request->image;
+	for (int64_t t = first; t <= last; ++t) {
 
-		} else if (current_request) {
-			if (current_request->finished ()) {
-				// There is a chance the request is now finished since checking above
-				image_to_draw = current_request->image;
-				current_request.reset ();
-			} else if (_canvas->get_microseconds_since_render_start () < 15000) {
-				current_request->cancel ();
-				current_request.reset ();
+		WaveViewProperties tile_props (*_props);
+		tile_props.set_tile (t);
 
-				// Drawing image in GUI thread as we have time
-
-				// now that we have to draw something, draw more than required.
-				request->image->props.set_width_samples (optimal_image_width_samples ());
+		if (tile_props.get_length_samples () == 0 || !tile_props.is_valid ()) {
+			continue;
+		}
 
-				process_draw_request (request);
+		boost::shared_ptr<WaveViewImage> const image = get_image (tile_props, t);
 
-				image_to_draw = request->image;
-			} else {
-				// Waiting for current request to finish
-				redraw ();
-				return;
-			}
+		if (image) {
+			images.push_back (image);
 		} else {
-			// Defer the rendering to another thread or perhaps render pass if
-			// a thread cannot generate it in time.
-			queue_draw_request (request);
-			redraw ();
-			return;
+			missing.push_back (t);
 		}
 	}
 
 	/* reset this so that future missing images can be generated in a worker thread. */
 	_draw_image_in_gui_thread = false;
 
-	assert (image_to_draw);
-
-	/* compute the first pixel of the image that should be used when we
-	 * render the specified range.
-	 */
-
-	double image_origin_in_self_coordinates =
-	    (image_to_draw->props.get_sample_start () - _props->region_start) / _props->samples_per_pixel;
+	if (!missing.empty ()) {
 
-	/* the image may only be a best-effort ... it may not span the entire
-	 * range requested, though it is guaranteed to cover the start. So
-	 * determine how many pixels we can actually draw.
-	 */
+		/* Until all tiles are drawn, show the images shown before, e.g.
+		 * at another zoom level or height, underneath those that are
+		 * available.
+		 */
+		std::vector<boost::shared_ptr<WaveViewImage> > previous;
 
-	const double draw_start_pixel = draw.x0;
-	const double draw_end_pixel = draw.x1;
+		for (std::vector<boost::shared_ptr<WaveViewImage> >::const_iterator i = _images.begin (); i != _images.end (); ++i) {
+			if (std::find (images.begin (), images.end (), *i) != images.end ()) {
+				continue;
+			}
+			if ((*i)->props.get_sample_end () > required_props.get_sample_start () &&
+			    (*i)->props.get_sample_start () < required_props.get_sample_end ()) {
+				draw_tile (context, *i, self, draw);
+			}
+			previous.push_back (*i);
+		}
 
-	double draw_width_pixels = draw_end_pixel - draw_start_pixel;
+		if (WaveViewThreads::enabled ()) {
+			// Defer the rendering to another thread or perhaps render pass if
+			// a thread cannot generate it in time.
+			queue_draw_requests (*_props, missing, false);
+			redraw ();
+		}
 
-	if (image_to_draw != _image) {
+		for (std::vector<boost::shared_ptr<WaveViewImage> >::const_iterator i = images.begin (); i != images.end (); ++i) {
+			draw_tile (context, *i, self, draw);
+		}
 
-		/* the image is guaranteed to start at or before
-		 * draw_start. But if it starts before draw_start, that reduces
-		 * the maximum available width we can render with.
-		 *
-		 * so .. clamp the draw width to the smaller of what we need to
-		 * draw or the available width of the image.
-		 */
-		draw_width_pixels = min ((double)image_to_draw->cairo_image->get_width (), draw_width_pixels);
+		// keep the previous images until all tiles are done
+		images.insert (images.end (), previous.begin (), previous.end ());
+		_images.swap (images);
 
-		set_image (image_to_draw);
+		return;
 	}
 
-	context->rectangle (draw_start_pixel, draw.y0, draw_width_pixels, draw.height());
-
-	/* round image origin position to an exact pixel in device space to
-	 * avoid blurring
-	 */
-
-	double x  = self.x0 + image_origin_in_self_coordinates;
-	double y  = self.y0;
-	context->user_to_device (x, y);
-	x = round (x);
-	y = round (y);
-	context->device_to_user (x, y);
-
-	/* the coordinates specify where in "user coordinates" (i.e. what we
-	 * generally call "canvas coordinates" in this code) the image origin
-	 * will appear. So specifying (10,10) will put the upper left corner of
-	 * the image at (10,10) in user space.
-	 */
+	for (std::vector<boost::shared_ptr<WaveViewImage> >::const_iterator i = images.begin (); i != images.end (); ++i) {
+		draw_tile (context, *i, self, draw);
+	}
 
-	context->set_source (image_to_draw->cairo_image, x, y);
-	context->fill ();
+	if (!images.empty ()) {
+		_images.swap (images);
+	}
 }
 
 void
@@ -1192,7 +1230,6 @@ WaveView::set_height (Distance height)
 		begin_change ();
 
 		_props->height = height;
-		_draw_image_in_gui_thread = true;
 
 		_bounding_box_dirty = true;
 		end_change ();
@@ -55,10 +55,11 @@ WaveViewProperties::WaveViewProperties (boost::shared_ptr<ARDOUR::AudioRegion> r
 /*-------------------------------------------------*/
 
 WaveViewImage::WaveViewImage (boost::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-                              WaveViewProperties const& properties)
+                              WaveViewProperties const& properties, int64_t tile_index)
 	: region (region_ptr)
 	, props (properties)
-	, timestamp (0)
+	, tile (tile_index)
+	, group (0)
 {
 
 }
@@ -89,62 +90,63 @@ WaveViewCacheGroup::add_image (boost::shared_ptr<WaveViewImage> image)
 		return;
 	}
 
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
-
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		if ((*it) == image) {
-			// Must never be more than one instance of the image in the cache
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		} else if ((*it)->props.is_equivalent (image->props)) {
-			// Equivalent Image already in cache, updating timestamp
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		}
+	if (image->group) {
+		// Must never be more than one instance of the image in the cache
+		_parent_cache.touch (image);
+		return;
+	}
 
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
+	WaveViewTileKey const key (image->props, image->tile);
+
+	std::pair<TileMap::iterator, TileMap::iterator> r = _tiles.equal_range (key);
+
+	for (TileMap::iterator i = r.first; i != r.second; ++i) {
+		if (i->second->props.is_equivalent (image->props)) {
+			if (i->second->finished () || !image->finished ()) {
+				// Equivalent Image already in cache
+				_parent_cache.touch (i->second);
+				return;
+			}
+			// Replacing an Image that is still being drawn
+			remove_image (i->second);
+			break;
 		}
 	}
 
-	// no duplicate or equivalent image so we are definitely adding it to cache
-	image->timestamp = g_get_monotonic_time ();
+	_tiles.insert (std::make_pair (key, image));
+	image->group = this;
+	_parent_cache.insert (image);
+}
 
-	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
+void
+WaveViewCacheGroup::remove_image (boost::shared_ptr<WaveViewImage> image)
+{
+	if (image->group != this) {
+		return;
+	}
 
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
-			}
-			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
+	std::pair<TileMap::iterator, TileMap::iterator> r = _tiles.equal_range (WaveViewTileKey (image->props, image->tile));
+
+	for (TileMap::iterator i = r.first; i != r.second; ++i) {
+		if (i->second == image) {
+			_tiles.erase (i);
+			break;
 		}
 	}
 
-	_cached_images.push_back (image);
-	_parent_cache.increase_size (image->size_in_bytes ());
+	image->group = 0;
+	_parent_cache.erase (image);
 }
 
 boost::shared_ptr<WaveViewImage>
-WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
+WaveViewCacheGroup::lookup_image (WaveViewProperties const& props, int64_t tile_index)
 {
-	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
-		if ((*i)->props.is_equivalent (props)) {
-			return (*i);
+	std::pair<TileMap::iterator, TileMap::iterator> r = _tiles.equal_range (WaveViewTileKey (props, tile_index));
+
+	for (TileMap::iterator i = r.first; i != r.second; ++i) {
+		if (i->second->props.is_equivalent (props)) {
+			_parent_cache.touch (i->second);
+			return i->second;
 		}
 	}
 	return boost::shared_ptr<WaveViewImage>();
@@ -153,11 +155,9 @@ WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
 void
 WaveViewCacheGroup::clear_cache ()
 {
-	// Tell the parent cache about the images we are about to drop references to
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		_parent_cache.decrease_size ((*it)->size_in_bytes ());
+	while (!_tiles.empty ()) {
+		remove_image (_tiles.begin ()->second);
 	}
-	_cached_images.clear ();
 }
 
 /*-------------------------------------------------*/
@@ -181,16 +181,30 @@ WaveViewCache::get_instance ()
 }
 
 void
-WaveViewCache::increase_size (uint64_t bytes)
+WaveViewCache::insert (boost::shared_ptr<WaveViewImage> const& image)
+{
+	image->lru_position = _images.insert (_images.end (), image);
+	image_cache_size += image->size_in_bytes ();
+
+	// drop the least recently used images, but never the one just added
+	while (full () && _images.front () != image) {
+		boost::shared_ptr<WaveViewImage> oldest = _images.front ();
+		oldest->group->remove_image (oldest);
+	}
+}
+
+void
+WaveViewCache::erase (boost::shared_ptr<WaveViewImage> const& image)
 {
-	image_cache_size += bytes;
+	assert (image_cache_size - image->size_in_bytes () <= image_cache_size);
+	image_cache_size -= image->size_in_bytes ();
+	_images.erase (image->lru_position);
 }
 
 void
-WaveViewCache::decrease_size (uint64_t bytes)
+WaveViewCache::touch (boost::shared_ptr<WaveViewImage> const& image)
 {
-	assert (image_cache_size - bytes < image_cache_size);
-	image_cache_size -= bytes;
+	_images.splice (_images.end (), _images, image->lru_position);
 }
 
 boost::shared_ptr<WaveViewCacheGroup>
@@ -22,6 +22,8 @@
 #ifndef _WAVEVIEW_WAVE_VIEW_H_
 #define _WAVEVIEW_WAVE_VIEW_H_
 
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 #include <boost/scoped_ptr.hpp>
 
@@ -66,11 +68,12 @@ public:
 	   when drawing, we will map the zeroth-pixel of the waveview
 	   into a window.
 
-	   The waveview itself contains a set of pre-rendered Cairo::ImageSurfaces
-	   that cache sections of the display. This is filled on-demand and
-	   never cleared until something explicitly marks the cache invalid
-	   (such as a change in samples_per_pixel, the log scaling, rectified or
-	   other view parameters).
+	   The waveform is drawn in fixed width tiles, pre-rendered
+	   Cairo::ImageSurfaces which are cached per source, zoom level and
+	   height, and shared by all regions of the source. Tiles next to the
+	   visible area are drawn ahead of time in worker threads. Until a
+	   tile is ready, the tiles previously shown are drawn instead,
+	   scaled to the current zoom level and height.
 	*/
 
 	WaveView (ArdourCanvas::Canvas*, boost::shared_ptr<ARDOUR::AudioRegion>);
@@ -165,7 +168,10 @@ private:
 
 	boost::scoped_ptr<WaveViewProperties> _props;
 
-	mutable boost::shared_ptr<WaveViewImage> _image;
+	/** the tiles drawn by the last render(), used in place of tiles that
+	 * are not drawn yet after a change of zoom level or height.
+	 */
+	mutable std::vector<boost::shared_ptr<WaveViewImage> > _images;
 
 	mutable boost::shared_ptr<WaveViewCacheGroup> _cache_group;
 
@@ -186,14 +192,15 @@ private:
 	ARDOUR::samplepos_t region_end () const;
 
 	/**
-	 * _image stays non-null after the first time it is set
+	 * _images stays non-empty after the first time it is set
 	 */
-	bool rendered () const { return _image.get(); }
+	bool rendered () const { return !_images.empty(); }
 
 	bool draw_image_in_gui_thread () const;
 
-	/** If true, calls to render() will render a missing wave image in the GUI
-	 * thread. Generally set to false, but true after a call to set_height().
+	/** If true, calls to render() will render missing tiles in the GUI
+	 * thread. Generally set to false, but true after a change of gain,
+	 * where the tiles shown before would be misleading.
 	 */
 	mutable bool _draw_image_in_gui_thread;
 
@@ -205,7 +212,8 @@ private:
 
 	void init();
 
-	mutable boost::shared_ptr<WaveViewDrawRequest> current_request;
+	/** requests for tiles that are visible or about to be */
+	mutable std::vector<boost::shared_ptr<WaveViewDrawRequest> > current_requests;
 
 	PBD::ScopedConnectionList invalidation_connection;
 
@@ -238,18 +246,31 @@ private:
 	                        boost::shared_ptr<WaveViewDrawRequest>);
 	static void draw_absent_image (Cairo::RefPtr<Cairo::ImageSurface>&, ARDOUR::PeakData*, int);
 
-	ARDOUR::samplecnt_t optimal_image_width_samples () const;
+	/** @return the number of tiles to draw ahead on either side of the visible area */
+	int64_t prefetch_tiles () const;
 
-	void set_image (boost::shared_ptr<WaveViewImage> img) const;
+	// @return a finished image of the tile, or null if there is none yet
+	boost::shared_ptr<WaveViewImage> get_image (WaveViewProperties const&, int64_t tile_index) const;
+
+	void draw_tile (Cairo::RefPtr<Cairo::Context> const&, boost::shared_ptr<WaveViewImage> const&,
+	                ArdourCanvas::Rect const& item_rect, ArdourCanvas::Rect const& draw_rect) const;
 
 	// @return true if item area intersects with draw area
 	bool get_item_and_draw_rect_in_window_coords (ArdourCanvas::Rect const& canvas_rect,
 	                                              ArdourCanvas::Rect& item_area,
 	                                              ArdourCanvas::Rect& draw_rect) const;
 
-	boost::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&) const;
+	boost::shared_ptr<WaveViewDrawRequest> create_draw_request (WaveViewProperties const&, int64_t tile_index) const;
+
+	/** Queue the tiles that are not cached or already being drawn.
+	 * @param props properties of the tiles
+	 * @param tiles tile indices, most important first
+	 * @param cancel_others cancel requests for all other tiles
+	 */
+	void queue_draw_requests (WaveViewProperties const& props, std::vector<int64_t> const& tiles,
+	                          bool cancel_others) const;
 
-	void queue_draw_request (boost::shared_ptr<WaveViewDrawRequest> const&) const;
+	void cancel_draw_request (boost::shared_ptr<WaveViewDrawRequest> const&) const;
 
 	static void process_draw_request (boost::shared_ptr<WaveViewDrawRequest>);
 
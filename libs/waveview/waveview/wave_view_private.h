@@ -21,6 +21,8 @@
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
 #include <deque>
+#include <list>
+#include <map>
 
 #include "waveview/wave_view.h"
 
@@ -70,6 +72,36 @@ public: // methods
 		return (sample_end != 0 && samples_per_pixel != 0);
 	}
 
+	/* Waveforms are drawn in tiles of a fixed width, so that the images of
+	 * a source can be shared by all its regions and reused when scrolling.
+	 * Tile N starts at sample N * tile_width * samples_per_pixel of the
+	 * source.
+	 */
+	static int64_t tile_width () { return 256; }
+
+	int64_t tile_index (samplepos_t s) const
+	{
+		return (int64_t) floor (s / (tile_width () * samples_per_pixel));
+	}
+
+	samplepos_t tile_start (int64_t index) const
+	{
+		return llrint (index * tile_width () * samples_per_pixel);
+	}
+
+	/** Set the sample range to the part of tile @a index within the region */
+	void set_tile (int64_t index)
+	{
+		set_sample_offsets (tile_start (index), tile_start (index + 1));
+	}
+
+	/** @return the range of tiles holding the samples in [start, end) */
+	void tile_range (samplepos_t start, samplepos_t end, int64_t& first, int64_t& last) const
+	{
+		first = tile_index (start);
+		last = tile_index (std::max (start, end - 1));
+	}
+
 	void set_width_samples (ARDOUR::samplecnt_t const width_samples)
 	{
 		assert (is_valid());
@@ -164,10 +196,16 @@ public: // methods
 	}
 };
 
+struct WaveViewImage;
+class WaveViewCacheGroup;
+
+// least recently used first
+typedef std::list<boost::shared_ptr<WaveViewImage> > WaveViewImageList;
+
 struct WaveViewImage {
 public: // ctors
 	WaveViewImage (boost::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
-	               WaveViewProperties const& properties);
+	               WaveViewProperties const& properties, int64_t tile_index);
 
 	~WaveViewImage ();
 
@@ -175,7 +213,11 @@ public: // member variables
 	boost::weak_ptr<const ARDOUR::AudioRegion> region;
 	WaveViewProperties props;
 	Cairo::RefPtr<Cairo::ImageSurface> cairo_image;
-	uint64_t timestamp;
+	int64_t tile;
+
+	// set while the image is in the cache
+	WaveViewCacheGroup* group;
+	WaveViewImageList::iterator lru_position;
 
 public: // methods
 	bool finished() { return static_cast<bool>(cairo_image); }
@@ -217,6 +259,30 @@ private:
 	gint stop; /* intended for atomic access */
 };
 
+struct WaveViewTileKey
+{
+	WaveViewTileKey (WaveViewProperties const& props, int64_t tile_index)
+		: samples_per_pixel (props.samples_per_pixel)
+		, height (props.height)
+		, index (tile_index)
+	{}
+
+	double  samples_per_pixel;
+	double  height;
+	int64_t index;
+
+	bool operator< (WaveViewTileKey const& other) const
+	{
+		if (samples_per_pixel != other.samples_per_pixel) {
+			return samples_per_pixel < other.samples_per_pixel;
+		}
+		if (height != other.height) {
+			return height < other.height;
+		}
+		return index < other.index;
+	}
+};
+
 class WaveViewCache;
 
 class WaveViewCacheGroup
@@ -228,14 +294,12 @@ public:
 
 public:
 
-	// @return image with matching properties or null
-	boost::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&);
+	// @return image of the given tile with matching properties or null
+	boost::shared_ptr<WaveViewImage> lookup_image (WaveViewProperties const&, int64_t tile_index);
 
 	void add_image (boost::shared_ptr<WaveViewImage>);
 
-	bool full () const { return _cached_images.size() > max_size(); }
-
-	static uint32_t max_size () { return 16; }
+	void remove_image (boost::shared_ptr<WaveViewImage>);
 
 	void clear_cache ();
 
@@ -248,8 +312,8 @@ private:
 	 */
 	WaveViewCache& _parent_cache;
 
-	typedef std::list<boost::shared_ptr<WaveViewImage> > ImageCache;
-	ImageCache _cached_images;
+	typedef std::multimap<WaveViewTileKey, boost::shared_ptr<WaveViewImage> > TileMap;
+	TileMap _tiles;
 };
 
 class WaveViewCache
@@ -276,14 +340,18 @@ private:
 
 	CacheGroups cache_group_map;
 
+	// all cached images of all groups
+	WaveViewImageList _images;
+
 	uint64_t image_cache_size;
 	uint64_t _image_cache_threshold;
 
 private:
 	friend class WaveViewCacheGroup;
 
-	void increase_size (uint64_t bytes);
-	void decrease_size (uint64_t bytes);
+	void insert (boost::shared_ptr<WaveViewImage> const&);
+	void erase (boost::shared_ptr<WaveViewImage> const&);
+	void touch (boost::shared_ptr<WaveViewImage> const&);
 
 	bool full () { return image_cache_size > _image_cache_threshold; }
 };
@@ -23,6 +23,7 @@ while [ $# -gt 1 ] ; do
 	-M) args="$args -M"; shift ;;
 	-D) args="$args -D"; shift ;;
 	-R) args="$args -R"; shift ;;
+	-P) args="$args -P"; shift ;;
         *) break ;;
     esac
 done
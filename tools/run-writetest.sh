@@ -4,6 +4,8 @@ dir=/tmp
 numfiles=128
 nocache=
 sync=
+prealloc=
+writebehind=
 filesize=`expr 10 \* 1048576`
 
 while [ $# -gt 1 ] ; do
@@ -12,6 +14,8 @@ while [ $# -gt 1 ] ; do
 	-n) numfiles=$2; shift; shift ;;
 	-D) nocache="-D"; shift ;;
         -s) sync="-s"; shift;;
+        -P) prealloc="-P"; shift;;
+        -W) writebehind="-W"; shift;;
         -S) filesize=$2; shift; shift ;;
         *) break ;;
     esac
@@ -21,6 +25,6 @@ rm -r $dir/sftest
 
 for bs in $@ ; do
     echo "Blocksize $bs"
-    ./sftest $sync $nocache -b $bs -q -d $dir -n $numfiles -S $filesize
+    ./sftest $sync $nocache $prealloc $writebehind -b $bs -q -d $dir -n $numfiles -S $filesize
     rm -r $dir/sftest
 done
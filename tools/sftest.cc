@@ -16,6 +16,10 @@
 #include <signal.h>
 #include <float.h>
 
+#ifdef __linux__
+#include <linux/falloc.h>
+#endif
+
 #include <glibmm/miscutils.h>
 
 using namespace std;
@@ -24,6 +28,9 @@ SF_INFO format_info;
 float* data = 0;
 bool with_sync = false;
 bool keep_writing = true;
+#ifdef __linux__
+bool write_behind = false;
+#endif
 
 void
 signal_handler (int)
@@ -31,16 +38,40 @@ signal_handler (int)
 	keep_writing = false;
 }
 
+struct File {
+	SNDFILE* sf;
+	int fd;
+	off_t writeback_start;
+	off_t writeback_end;
+};
+
 int
-write_one (SNDFILE* sf, uint32_t nframes)
+write_one (File& f, uint32_t nframes)
 {
-	if (sf_write_float (sf, (float*) data, nframes) != nframes) {
+	if (sf_write_float (f.sf, (float*) data, nframes) != nframes) {
 		return -1;
 	}
 
 	if (with_sync) {
-		sf_write_sync (sf);
+		sf_write_sync (f.sf);
+	}
+
+#ifdef __linux__
+	if (write_behind) {
+		/* start writeback of this block, wait for the previous one and drop it from the page cache
+		 * (what SndFileSource does with capture-write-behind enabled)
+		 */
+		off_t pos = lseek (f.fd, 0, SEEK_CUR);
+		sync_file_range (f.fd, f.writeback_end, pos - f.writeback_end, SYNC_FILE_RANGE_WRITE);
+		if (f.writeback_end > f.writeback_start) {
+			sync_file_range (f.fd, f.writeback_start, f.writeback_end - f.writeback_start,
+			                 SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+			posix_fadvise (f.fd, f.writeback_start, f.writeback_end - f.writeback_start, POSIX_FADV_DONTNEED);
+		}
+		f.writeback_start = f.writeback_end;
+		f.writeback_end = pos;
 	}
+#endif
 
 	return 0;
 }
@@ -52,6 +83,9 @@ usage ()
 
 #ifdef __APPLE__
 	cout << " [ -D ]";
+#endif
+#ifdef __linux__
+	cout << " [ -P ] [ -W ]";
 #endif
 	cout << endl;
 
@@ -64,16 +98,22 @@ usage ()
 	     << "\t\t32" << endl
 	     << "\t\t24" << endl
 	     << "\t\t16" << endl;
+#ifdef __linux__
+	cout << "\t-P preallocates the files, -W writes behind (see capture-write-behind)" << endl;
+#endif
 }
 
 int
 main (int argc, char* argv[])
 {
-	vector<SNDFILE*> sndfiles;
+	vector<File> sndfiles;
 	uint32_t sample_size;
 	char optstring[] = "f:r:F:n:c:b:sd:qS:"
 #ifdef __APPLE__
 		"D"
+#endif
+#ifdef __linux__
+		"PW"
 #endif
 		;
 	int channels = 1;
@@ -88,6 +128,9 @@ main (int argc, char* argv[])
 	bool quiet = false;
 #ifdef __APPLE__
         bool direct = false;
+#endif
+#ifdef __linux__
+	bool preallocate = false;
 #endif
 	const struct option longopts[] = {
 		{ "header-format", 1, 0, 'f' },
@@ -102,6 +145,10 @@ main (int argc, char* argv[])
 		{ "filesize", 1, 0, 'S' },
 #ifdef __APPLE__
 		{ "direct", 0, 0, 'D' },
+#endif
+#ifdef __linux__
+		{ "preallocate", 0, 0, 'P' },
+		{ "write-behind", 0, 0, 'W' },
 #endif
 		{ 0, 0, 0, 0 }
 	};
@@ -147,6 +194,14 @@ main (int argc, char* argv[])
                 case 'D':
                         direct = true;
                         break;
+#endif
+#ifdef __linux__
+		case 'P':
+			preallocate = true;
+			break;
+		case 'W':
+			write_behind = true;
+			break;
 #endif
 		case 'd':
 			dirname = optarg;
@@ -237,19 +292,31 @@ main (int argc, char* argv[])
                                 cerr << "Cannot set F_NOCACHE on file # " << n << endl;
                         }
                 }
+#endif
+#ifdef __linux__
+		if (preallocate) {
+			/* keep the size: libsndfile must see an empty file */
+			if (fallocate (fd, FALLOC_FL_KEEP_SIZE, 0, (off_t) filesize * channels * sample_size) != 0) {
+				cerr << "Cannot preallocate file # " << n << " (" << strerror (errno) << ")" << endl;
+			}
+		}
 #endif
 		if ((sf = sf_open_fd (fd, SFM_RDWR, &format_info, true)) == 0) {
 			cerr << "Could not open SNDFILE #" << n << " @ " << path << " (" << sf_strerror (0) << ")" << endl;
 			return 1;
 		}
 
-		sndfiles.push_back (sf);
+		File f = { sf, fd, 0, 0 };
+		sndfiles.push_back (f);
 	}
 
 	if (!quiet) {
 		cout << nfiles << " files are in " << tmpdirname;
 #ifdef __APPLE__
 		cout << " all used " << (direct ? "without" : "with") << " OS buffer cache";
+#endif
+#ifdef __linux__
+		cout << (preallocate ? ", preallocated" : "") << (write_behind ? ", written behind" : "");
 #endif
 		cout << endl;
 		cout << "Format is " << suffix << ' ' << channels << " channel" << (channels > 1 ? "s" : "") << " written in chunks of " << block_size << " samples, synced ? " << (with_sync ? "yes" : "no") << endl;
@@ -268,7 +335,7 @@ main (int argc, char* argv[])
 	while (keep_writing && written < filesize) {
 		gint64 before;
 		before = g_get_monotonic_time();
-		for (vector<SNDFILE*>::iterator s = sndfiles.begin(); s != sndfiles.end(); ++s) {
+		for (vector<File>::iterator s = sndfiles.begin(); s != sndfiles.end(); ++s) {
 			if (write_one (*s, block_size)) {
 				cerr << "Write failed for file #" << distance (sndfiles.begin(), s) << endl;
 				return 1;
@@ -295,8 +362,8 @@ main (int argc, char* argv[])
 
 	if (!quiet) {
 		cout << "Closing files ...\n";
-		for (vector<SNDFILE*>::iterator s = sndfiles.begin(); s != sndfiles.end(); ++s) {
-		sf_close (*s);
+		for (vector<File>::iterator s = sndfiles.begin(); s != sndfiles.end(); ++s) {
+		sf_close (s->sf);
 		}
 		cout << "Done.\n";
 	}
@@ -27,7 +27,10 @@ char* data = 0;
 void
 usage ()
 {
-	fprintf (stderr, "thread_readtest [ -b BLOCKSIZE ] [ -l FILELIMIT] [ -n NTHREADS ] [ -D ] [ -R ] [ -M ] filename-template\n");
+	fprintf (stderr, "thread_readtest [ -b BLOCKSIZE ] [ -l FILELIMIT] [ -n NTHREADS ] [ -D ] [ -R ] [ -M ] [ -P ] filename-template\n");
+#ifdef __linux__
+	fprintf (stderr, "\t-P: before each pass, ask the kernel to read ahead the following block of all files (see batch-disk-reads)\n");
+#endif
 }
 
 Glib::Threads::Cond pool_run;
@@ -159,7 +162,7 @@ int
 main (int argc, char* argv[])
 {
 	int* files;
-	char optstring[] = "b:DRMl:q";
+	char optstring[] = "b:DRMl:qP";
 	uint32_t block_size = 64 * 1024 * 4;
 	int max_files = -1;
 	int nthreads = 16;
@@ -167,6 +170,7 @@ main (int argc, char* argv[])
 	int direct = 0;
 	int noreadahead = 0;
 #endif
+	int prefetch = 0;
 #ifdef HAVE_MMAP
 	int use_mmap = 0;
 	void  **addr;
@@ -179,6 +183,7 @@ main (int argc, char* argv[])
 		{ "noreadahead", 0, 0, 'R' },
 		{ "limit", 1, 0, 'l' },
 		{ "nthreads", 16, 0, 'n' },
+		{ "prefetch", 0, 0, 'P' },
 		{ 0, 0, 0, 0 }
 	};
 
@@ -220,6 +225,9 @@ main (int argc, char* argv[])
 		case 'q':
 			quiet = 1;
 			break;
+		case 'P':
+			prefetch = 1;
+			break;
 		case 'n':
 			nthreads = atoi (optarg);
 			break;
@@ -336,10 +344,25 @@ main (int argc, char* argv[])
 
 	build_thread_pool (nthreads, block_size);
 
+	if (!quiet && prefetch) {
+		printf ("# Prefetching the next block of each file.\n");
+	}
+
 	while (1) {
 		gint64 before;
 		before = g_get_monotonic_time();
 
+#ifdef __linux__
+		if (prefetch) {
+			/* the block after the one read in this pass, in file order; this
+			 * does not wait, the threads read the current block meanwhile.
+			 */
+			for (n = 0; n < nfiles; ++n) {
+				posix_fadvise (files[n], _read + block_size, block_size, POSIX_FADV_WILLNEED);
+			}
+		}
+#endif
+
 		if (run_thread_pool (files, nfiles)) {
 			fprintf (stderr, "thread pool error\n");
 			goto out;